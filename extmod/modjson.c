@@ -25,6 +25,8 @@
  */
 
 #include <stdio.h>
+// CIRCUITPY-CHANGE
+#include <string.h>
 
 // CIRCUITPY-CHANGE
 #include "py/binary.h"
@@ -37,6 +39,49 @@
 
 #if MICROPY_PY_JSON
 
+// CIRCUITPY-CHANGE
+// json.dump collects the many small fragments that printing produces into
+// writes of up to this size.
+#define CIRCUITPY_JSON_WRITE_CHUNK_SIZE 256
+
+typedef struct _json_write_buffer_t {
+    mp_obj_t stream_obj;
+    size_t len;
+    char buf[CIRCUITPY_JSON_WRITE_CHUNK_SIZE];
+} json_write_buffer_t;
+
+static void json_write_buffer_flush(json_write_buffer_t *wb) {
+    if (wb->len) {
+        mp_stream_write_adaptor(MP_OBJ_TO_PTR(wb->stream_obj), wb->buf, wb->len);
+        wb->len = 0;
+    }
+}
+
+static void json_write_buffer_strn(void *data, const char *str, size_t len) {
+    json_write_buffer_t *wb = data;
+    if (wb->len + len > sizeof(wb->buf)) {
+        json_write_buffer_flush(wb);
+        if (len > sizeof(wb->buf)) {
+            // Long strings go straight to the stream.
+            mp_stream_write_adaptor(MP_OBJ_TO_PTR(wb->stream_obj), str, len);
+            return;
+        }
+    }
+    memcpy(wb->buf + wb->len, str, len);
+    wb->len += len;
+}
+
+static void json_dump_to_stream(mp_print_t *print, mp_obj_t obj, mp_obj_t stream_obj) {
+    mp_get_stream_raise(stream_obj, MP_STREAM_OP_WRITE);
+    json_write_buffer_t wb;
+    wb.stream_obj = stream_obj;
+    wb.len = 0;
+    print->data = &wb;
+    print->print_strn = json_write_buffer_strn;
+    mp_obj_print_helper(print, obj, PRINT_JSON);
+    json_write_buffer_flush(&wb);
+}
+
 #if MICROPY_PY_JSON_SEPARATORS
 
 enum {
@@ -73,10 +118,8 @@ static mp_obj_t mod_json_dump_helper(size_t n_args, const mp_obj_t *pos_args, mp
         return mp_obj_new_str_from_utf8_vstr(&vstr);
     } else {
         // dump(obj, stream)
-        print_ext.base.data = MP_OBJ_TO_PTR(pos_args[1]);
-        print_ext.base.print_strn = mp_stream_write_adaptor;
-        mp_get_stream_raise(pos_args[1], MP_STREAM_OP_WRITE);
-        mp_obj_print_helper(&print_ext.base, pos_args[0], PRINT_JSON);
+        // CIRCUITPY-CHANGE
+        json_dump_to_stream(&print_ext.base, pos_args[0], pos_args[1]);
         return mp_const_none;
     }
 }
@@ -94,9 +137,9 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(mod_json_dumps_obj, 1, mod_json_dumps);
 #else
 
 static mp_obj_t mod_json_dump(mp_obj_t obj, mp_obj_t stream) {
-    mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
-    mp_print_t print = {MP_OBJ_TO_PTR(stream), mp_stream_write_adaptor};
-    mp_obj_print_helper(&print, obj, PRINT_JSON);
+    // CIRCUITPY-CHANGE
+    mp_print_t print;
+    json_dump_to_stream(&print, obj, stream);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(mod_json_dump_obj, mod_json_dump);
@@ -130,91 +173,248 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_dumps_obj, mod_json_dumps);
 // strings).  It does 1 pass over the input stream.  It tries to be fast and
 // small in code size, while not using more RAM than necessary.
 
+// CIRCUITPY-CHANGE: input is consumed a block at a time. In-memory input
+// (loads, or a buffer given to iterload) is parsed in place with no copying.
+
+// We read from streams in chunks larger than the json parser needs to reduce
+// the number of function calls done.
+#define CIRCUITPY_JSON_READ_CHUNK_SIZE 256
+
 typedef struct _json_stream_t {
     mp_obj_t stream_obj;
+    // NULL for in-memory input
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     int errcode;
     // CIRCUITPY-CHANGE
     mp_obj_t python_readinto[2 + 1];
     mp_obj_array_t bytearray_obj;
-    size_t start;
-    size_t end;
+    // For in-memory input, the object whose buffer is being parsed
+    mp_obj_t buffer_obj;
+    const byte *buf;
+    size_t pos; // next byte of buf to become cur
+    size_t len;
+    // How much to ask the stream for at a time. 1 for streams that can't be
+    // rewound, so that load() doesn't consume data after the JSON value.
+    size_t chunk_size;
+    byte *chunk;
     byte cur;
 } json_stream_t;
 
 #define S_EOF (0) // null is not allowed in json stream so is ok as EOF marker
 #define S_END(s) ((s).cur == S_EOF)
 #define S_CUR(s) ((s).cur)
-#define S_NEXT(s) (json_stream_next(&(s)))
+#define S_NEXT(s) ((s).pos < (s).len ? ((s).cur = (s).buf[(s).pos++]) : json_stream_next(&(s)))
 
+// Called when the current block is used up.
 static byte json_stream_next(json_stream_t *s) {
-    mp_uint_t ret = s->read(s->stream_obj, &s->cur, 1, &s->errcode);
+    s->cur = S_EOF;
+    if (s->read == NULL) {
+        return S_EOF;
+    }
+    mp_uint_t ret = s->read(s->stream_obj, s->chunk, s->chunk_size, &s->errcode);
     // CIRCUITPY-CHANGE
-    JSON_DEBUG("  usjon_stream_next err:%2d cur: %c \n", s->errcode, s->cur);
-    if (s->errcode != 0) {
+    JSON_DEBUG("  usjon_stream_next err:%2d ret: %d \n", s->errcode, ret);
+    if (ret == MP_STREAM_ERROR) {
         mp_raise_OSError(s->errcode);
     }
     if (ret == 0) {
-        s->cur = S_EOF;
+        return S_EOF;
     }
+    s->buf = s->chunk;
+    s->pos = 1;
+    s->len = ret;
+    s->cur = s->buf[0];
     return s->cur;
 }
 
 // CIRCUITPY-CHANGE
-
-// We read from an object's `readinto` method in chunks larger than the json
-// parser needs to reduce the number of function calls done.
-
-#define CIRCUITPY_JSON_READ_CHUNK_SIZE 64
-
 static mp_uint_t json_python_readinto(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode) {
-    (void)size;  // Ignore size because we know it's always 1.
+    // buf and size are always the chunk that bytearray_obj wraps.
+    (void)buf;
+    (void)size;
     json_stream_t *s = obj;
+    *errcode = 0;
+    mp_obj_t ret = mp_call_method_n_kw(1, 0, s->python_readinto);
+    if (ret == mp_const_none) {
+        *errcode = MP_EAGAIN;
+        return MP_STREAM_ERROR;
+    }
+    return mp_obj_get_int(ret);
+}
 
-    if (s->start == s->end) {
-        *errcode = 0;
-        mp_obj_t ret = mp_call_method_n_kw(1, 0, s->python_readinto);
-        if (ret == mp_const_none) {
-            *errcode = MP_EAGAIN;
-            return MP_STREAM_ERROR;
+// Sets up s to read from stream_obj, which may be a native stream, an object
+// with a readinto method, or (if allow_buffer) an object with the buffer protocol.
+static void json_stream_init(json_stream_t *s, mp_obj_t stream_obj, byte *chunk, bool allow_buffer) {
+    s->errcode = 0;
+    s->cur = 0;
+    s->buffer_obj = MP_OBJ_NULL;
+    s->pos = 0;
+    s->len = 0;
+    s->chunk = chunk;
+    s->chunk_size = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
+    mp_buffer_info_t bufinfo;
+    if (stream_p == NULL && allow_buffer && mp_get_buffer(stream_obj, &bufinfo, MP_BUFFER_READ)) {
+        s->read = NULL;
+        s->buffer_obj = stream_obj;
+        s->buf = bufinfo.buf;
+        s->len = bufinfo.len;
+    } else if (stream_p == NULL) {
+        mp_load_method(stream_obj, MP_QSTR_readinto, s->python_readinto);
+        s->bytearray_obj.base.type = &mp_type_bytearray;
+        s->bytearray_obj.typecode = BYTEARRAY_TYPECODE;
+        s->bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+        s->bytearray_obj.free = 0;
+        s->bytearray_obj.items = chunk;
+        s->python_readinto[2] = MP_OBJ_FROM_PTR(&s->bytearray_obj);
+        s->stream_obj = s;
+        s->read = json_python_readinto;
+    } else {
+        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+        s->stream_obj = stream_obj;
+        s->read = stream_p->read;
+        int errcode;
+        if (stream_p->ioctl == NULL || mp_stream_seek(stream_obj, 0, MP_SEEK_CUR, &errcode) == (mp_off_t)-1) {
+            s->chunk_size = 1;
         }
-        s->start = 0;
-        s->end = mp_obj_get_int(ret);
-        if (s->end == 0) {
-            return 0;
+    }
+}
+
+// Puts back what was read from a seekable stream beyond the current character,
+// leaving the stream where byte-at-a-time reading would have.
+static void json_stream_unread(json_stream_t *s) {
+    if (s->read != NULL && s->read != json_python_readinto && s->len > s->pos) {
+        mp_stream_seek(s->stream_obj, -(mp_off_t)(s->len - s->pos), MP_SEEK_CUR, &s->errcode);
+        s->len = s->pos;
+    }
+}
+
+// In-memory input may have been resized since the last call.
+static void json_stream_refresh(json_stream_t *s) {
+    if (s->buffer_obj != MP_OBJ_NULL) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(s->buffer_obj, &bufinfo, MP_BUFFER_READ);
+        s->buf = bufinfo.buf;
+        s->len = bufinfo.len;
+        if (s->pos > s->len) {
+            s->pos = s->len;
         }
     }
+}
 
-    *((uint8_t *)buf) = ((uint8_t *)s->bytearray_obj.items)[s->start];
-    s->start++;
-    return 1;
+static NORETURN void json_fail(void) {
+    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
 }
 
-static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
-    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
-    json_stream_t s;
-    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
-    if (stream_p == NULL) {
-        s.start = 0;
-        s.end = 0;
-        mp_load_method(stream_obj, MP_QSTR_readinto, s.python_readinto);
-        s.bytearray_obj.base.type = &mp_type_bytearray;
-        s.bytearray_obj.typecode = BYTEARRAY_TYPECODE;
-        s.bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
-        s.bytearray_obj.free = 0;
-        s.bytearray_obj.items = character_buffer;
-        s.python_readinto[2] = MP_OBJ_FROM_PTR(&s.bytearray_obj);
-        s.stream_obj = &s;
-        s.read = json_python_readinto;
-    } else {
-        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-        s.stream_obj = stream_obj;
-        s.read = stream_p->read;
-        s.errcode = 0;
-        s.cur = 0;
+static bool json_is_separator(byte c) {
+    return c == ',' || c == ':' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static void json_skip_separators(json_stream_t *s) {
+    while (json_is_separator(S_CUR(*s))) {
+        S_NEXT(*s);
     }
+}
 
-    JSON_DEBUG("got JSON stream\n");
+// Parses the rest of a string whose opening quote has been consumed, leaving
+// the result in vstr.
+static void json_parse_string(json_stream_t *s, vstr_t *vstr) {
+    vstr_reset(vstr);
+    for (; !S_END(*s) && S_CUR(*s) != '"';) {
+        byte c = S_CUR(*s);
+        if (c == '\\') {
+            c = S_NEXT(*s);
+            switch (c) {
+                case 'b':
+                    c = 0x08;
+                    break;
+                case 'f':
+                    c = 0x0c;
+                    break;
+                case 'n':
+                    c = 0x0a;
+                    break;
+                case 'r':
+                    c = 0x0d;
+                    break;
+                case 't':
+                    c = 0x09;
+                    break;
+                case 'u': {
+                    mp_uint_t num = 0;
+                    for (int i = 0; i < 4; i++) {
+                        c = (S_NEXT(*s) | 0x20) - '0';
+                        if (c > 9) {
+                            c -= ('a' - ('9' + 1));
+                        }
+                        num = (num << 4) | c;
+                    }
+                    vstr_add_char(vstr, num);
+                    goto str_cont;
+                }
+            }
+        }
+        vstr_add_byte(vstr, c);
+    str_cont:
+        S_NEXT(*s);
+    }
+    if (S_END(*s)) {
+        json_fail();
+    }
+    S_NEXT(*s);
+}
+
+// Skips over the value starting at the current character without creating
+// any objects.
+static void json_skip_value(json_stream_t *s) {
+    size_t depth = 0;
+    do {
+        byte c = S_CUR(*s);
+        if (c == S_EOF) {
+            json_fail();
+        }
+        S_NEXT(*s);
+        switch (c) {
+            case '"':
+                while (S_CUR(*s) != '"') {
+                    if (S_CUR(*s) == '\\') {
+                        S_NEXT(*s);
+                    }
+                    if (S_END(*s)) {
+                        json_fail();
+                    }
+                    S_NEXT(*s);
+                }
+                S_NEXT(*s);
+                break;
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (depth == 0) {
+                    json_fail();
+                }
+                depth--;
+                break;
+            default:
+                if (json_is_separator(c)) {
+                    break;
+                }
+                // The rest of a number or of null, true or false.
+                while (!S_END(*s) && !json_is_separator(S_CUR(*s))
+                       && S_CUR(*s) != ']' && S_CUR(*s) != '}') {
+                    S_NEXT(*s);
+                }
+                break;
+        }
+    } while (depth > 0);
+}
+
+// Parses one value starting at the current character. On return the current
+// character is the one following the value.
+static mp_obj_t json_parse_value(json_stream_t *s) {
     vstr_t vstr;
     vstr_init(&vstr, 8);
     mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
@@ -223,16 +423,15 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
     mp_obj_t stack_top = MP_OBJ_NULL;
     const mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
     for (;;) {
     cont:
-        if (S_END(s)) {
+        if (S_END(*s)) {
             break;
         }
         mp_obj_t next = MP_OBJ_NULL;
         bool enter = false;
-        byte cur = S_CUR(s);
-        S_NEXT(s);
+        byte cur = S_CUR(*s);
+        S_NEXT(*s);
         switch (cur) {
             case ',':
             case ':':
@@ -242,73 +441,31 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
             case '\r':
                 goto cont;
             case 'n':
-                if (S_CUR(s) == 'u' && S_NEXT(s) == 'l' && S_NEXT(s) == 'l') {
-                    S_NEXT(s);
+                if (S_CUR(*s) == 'u' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 'l') {
+                    S_NEXT(*s);
                     next = mp_const_none;
                 } else {
                     goto fail;
                 }
                 break;
             case 'f':
-                if (S_CUR(s) == 'a' && S_NEXT(s) == 'l' && S_NEXT(s) == 's' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
+                if (S_CUR(*s) == 'a' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 's' && S_NEXT(*s) == 'e') {
+                    S_NEXT(*s);
                     next = mp_const_false;
                 } else {
                     goto fail;
                 }
                 break;
             case 't':
-                if (S_CUR(s) == 'r' && S_NEXT(s) == 'u' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
+                if (S_CUR(*s) == 'r' && S_NEXT(*s) == 'u' && S_NEXT(*s) == 'e') {
+                    S_NEXT(*s);
                     next = mp_const_true;
                 } else {
                     goto fail;
                 }
                 break;
             case '"':
-                vstr_reset(&vstr);
-                for (; !S_END(s) && S_CUR(s) != '"';) {
-                    byte c = S_CUR(s);
-                    if (c == '\\') {
-                        c = S_NEXT(s);
-                        switch (c) {
-                            case 'b':
-                                c = 0x08;
-                                break;
-                            case 'f':
-                                c = 0x0c;
-                                break;
-                            case 'n':
-                                c = 0x0a;
-                                break;
-                            case 'r':
-                                c = 0x0d;
-                                break;
-                            case 't':
-                                c = 0x09;
-                                break;
-                            case 'u': {
-                                mp_uint_t num = 0;
-                                for (int i = 0; i < 4; i++) {
-                                    c = (S_NEXT(s) | 0x20) - '0';
-                                    if (c > 9) {
-                                        c -= ('a' - ('9' + 1));
-                                    }
-                                    num = (num << 4) | c;
-                                }
-                                vstr_add_char(&vstr, num);
-                                goto str_cont;
-                            }
-                        }
-                    }
-                    vstr_add_byte(&vstr, c);
-                str_cont:
-                    S_NEXT(s);
-                }
-                if (S_END(s)) {
-                    goto fail;
-                }
-                S_NEXT(s);
+                json_parse_string(s, &vstr);
                 next = mp_obj_new_str(vstr.buf, vstr.len);
                 break;
             case '-':
@@ -326,7 +483,7 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                 vstr_reset(&vstr);
                 for (;;) {
                     vstr_add_byte(&vstr, cur);
-                    cur = S_CUR(s);
+                    cur = S_CUR(*s);
                     if (cur == '.' || cur == 'E' || cur == 'e') {
                         flt = true;
                     } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
@@ -334,7 +491,7 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                     } else {
                         break;
                     }
-                    S_NEXT(s);
+                    S_NEXT(*s);
                 }
                 if (flt) {
                     next = mp_parse_num_float(vstr.buf, vstr.len, false, NULL);
@@ -404,6 +561,85 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
         }
     }
 success:
+    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
+        // not exactly 1 object
+        goto fail;
+    }
+    vstr_clear(&vstr);
+    return stack_top;
+
+fail:
+    json_fail();
+}
+
+// CIRCUITPY-CHANGE
+// Moves to the value found by following path, a sequence of object keys and
+// array indices, skipping everything before it.
+static void json_select(json_stream_t *s, mp_obj_t path) {
+    size_t path_len;
+    mp_obj_t *path_items;
+    mp_obj_get_array(path, &path_len, &path_items);
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    for (size_t i = 0; i < path_len; i++) {
+        json_skip_separators(s);
+        mp_obj_t item = path_items[i];
+        if (mp_obj_is_str(item)) {
+            if (S_CUR(*s) != '{') {
+                mp_raise_type_arg(&mp_type_KeyError, item);
+            }
+            S_NEXT(*s);
+            size_t key_len;
+            const char *key = mp_obj_str_get_data(item, &key_len);
+            for (;;) {
+                json_skip_separators(s);
+                if (S_CUR(*s) != '"') {
+                    mp_raise_type_arg(&mp_type_KeyError, item);
+                }
+                S_NEXT(*s);
+                json_parse_string(s, &vstr);
+                json_skip_separators(s);
+                if (vstr.len == key_len && memcmp(vstr.buf, key, key_len) == 0) {
+                    break;
+                }
+                json_skip_value(s);
+            }
+        } else {
+            mp_int_t index = mp_obj_get_int(item);
+            if (S_CUR(*s) != '[') {
+                mp_raise_type_arg(&mp_type_IndexError, item);
+            }
+            S_NEXT(*s);
+            for (mp_int_t j = 0;; j++) {
+                json_skip_separators(s);
+                if (index < 0 || S_CUR(*s) == ']' || S_END(*s)) {
+                    mp_raise_type_arg(&mp_type_IndexError, item);
+                }
+                if (j == index) {
+                    break;
+                }
+                json_skip_value(s);
+            }
+        }
+    }
+    json_skip_separators(s);
+    vstr_clear(&vstr);
+}
+
+static mp_obj_t _mod_json_load(mp_obj_t stream_obj, mp_obj_t path, bool return_first_json) {
+    json_stream_t s;
+    byte chunk[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+    json_stream_init(&s, stream_obj, chunk, !return_first_json);
+    JSON_DEBUG("got JSON stream\n");
+
+    S_NEXT(s);
+    if (path != mp_const_none) {
+        json_select(&s, path);
+        // The rest of the document is neither read nor checked.
+        return json_parse_value(&s);
+    }
+    mp_obj_t result = json_parse_value(&s);
+
     // CIRCUITPY-CHANGE
 
     // It is legal for a stream to have contents after JSON.
@@ -416,35 +652,118 @@ success:
         }
         if (!S_END(s)) {
             // unexpected chars
-            goto fail;
+            json_fail();
         }
+    } else {
+        json_stream_unread(&s);
     }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
-    }
-    vstr_clear(&vstr);
-    return stack_top;
-
-fail:
-    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+    return result;
 }
 
 // CIRCUITPY-CHANGE
-static mp_obj_t mod_json_load(mp_obj_t stream_obj) {
-    return _mod_json_load(stream_obj, true);
+static mp_obj_t mod_json_load(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_stream, ARG_path };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_path, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    return _mod_json_load(args[ARG_stream].u_obj, args[ARG_path].u_obj, true);
 }
-static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_load_obj, mod_json_load);
+static MP_DEFINE_CONST_FUN_OBJ_KW(mod_json_load_obj, 1, mod_json_load);
 
-static mp_obj_t mod_json_loads(mp_obj_t obj) {
+static mp_obj_t mod_json_loads(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_obj, ARG_path };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_obj, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_path, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(obj, &bufinfo, MP_BUFFER_READ);
-    vstr_t vstr = {bufinfo.len, bufinfo.len, (char *)bufinfo.buf, true};
-    mp_obj_stringio_t sio = {{&mp_type_stringio}, &vstr, 0, MP_OBJ_NULL};
-    // CIRCUITPY-CHANGE
-    return _mod_json_load(MP_OBJ_FROM_PTR(&sio), false);
+    mp_get_buffer_raise(args[ARG_obj].u_obj, &bufinfo, MP_BUFFER_READ);
+    // CIRCUITPY-CHANGE: parse the buffer in place
+    return _mod_json_load(args[ARG_obj].u_obj, args[ARG_path].u_obj, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mod_json_loads_obj, 1, mod_json_loads);
+
+// CIRCUITPY-CHANGE
+typedef struct _mp_obj_json_iter_t {
+    mp_obj_base_t base;
+    json_stream_t s;
+    bool is_object;
+    bool done;
+    byte chunk[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+} mp_obj_json_iter_t;
+
+static mp_obj_t json_iter_iternext(mp_obj_t self_in) {
+    mp_obj_json_iter_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->done) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    json_stream_t *s = &self->s;
+    json_stream_refresh(s);
+    json_skip_separators(s);
+    if (S_CUR(*s) == (self->is_object ? '}' : ']')) {
+        S_NEXT(*s);
+        self->done = true;
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (!self->is_object) {
+        return json_parse_value(s);
+    }
+    if (S_CUR(*s) != '"') {
+        json_fail();
+    }
+    S_NEXT(*s);
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    json_parse_string(s, &vstr);
+    mp_obj_t items[2] = { mp_obj_new_str(vstr.buf, vstr.len), MP_OBJ_NULL };
+    vstr_clear(&vstr);
+    json_skip_separators(s);
+    items[1] = json_parse_value(s);
+    return mp_obj_new_tuple(2, items);
 }
-static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_loads_obj, mod_json_loads);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_json_iter,
+    MP_QSTR_iterator,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    iter, json_iter_iternext
+    );
+
+static mp_obj_t mod_json_iterload(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_stream, ARG_path };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_path, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_json_iter_t *self = mp_obj_malloc(mp_obj_json_iter_t, &mp_type_json_iter);
+    json_stream_t *s = &self->s;
+    json_stream_init(s, args[ARG_stream].u_obj, self->chunk, true);
+    self->done = false;
+    S_NEXT(*s);
+    if (args[ARG_path].u_obj != mp_const_none) {
+        json_select(s, args[ARG_path].u_obj);
+    } else {
+        json_skip_separators(s);
+    }
+    if (S_CUR(*s) == '[') {
+        self->is_object = false;
+    } else if (S_CUR(*s) == '{') {
+        self->is_object = true;
+    } else {
+        mp_raise_TypeError(MP_ERROR_TEXT("expected an array or object"));
+    }
+    S_NEXT(*s);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mod_json_iterload_obj, 1, mod_json_iterload);
 
 static const mp_rom_map_elem_t mp_module_json_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_json) },
@@ -452,6 +771,8 @@ static const mp_rom_map_elem_t mp_module_json_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_json_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_json_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_json_loads_obj) },
+    // CIRCUITPY-CHANGE
+    { MP_ROM_QSTR(MP_QSTR_iterload), MP_ROM_PTR(&mod_json_iterload_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_json_globals, mp_module_json_globals_table);
@@ -39,8 +39,6 @@
 
 #if MICROPY_PY_RE
 
-#define re1_5_stack_chk() MP_STACK_CHECK()
-
 #include "lib/re1.5/re1.5.h"
 
 #define FLAG_DEBUG 0x1000
@@ -62,6 +60,55 @@ static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args);
 static const mp_obj_type_t re_type;
 #endif
 
+// CIRCUITPY-CHANGE: matching uses the Pike VM, which needs a work area
+// bounded by the program size rather than C stack proportional to the
+// subject, and runs in linear time.
+static void *re_work_new(mp_obj_re_t *self, int caps_num, size_t *size) {
+    *size = re1_5_pikevm_worksize(&self->re, caps_num);
+    return m_new(char, *size);
+}
+
+#if MICROPY_PY_RE_CACHE_SIZE && !MICROPY_ENABLE_DYNRUNTIME
+// (pattern, compiled) pairs used by the module-level functions, most
+// recently used first.
+MP_REGISTER_ROOT_POINTER(mp_obj_t re_cache[MICROPY_PY_RE_CACHE_SIZE * 2]);
+#endif
+
+static mp_obj_re_t *re_compile_cached(mp_obj_t pattern) {
+    #if MICROPY_PY_RE_CACHE_SIZE && !MICROPY_ENABLE_DYNRUNTIME
+    if (mp_obj_is_str_or_bytes(pattern)) {
+        mp_obj_t *cache = MP_STATE_VM(re_cache);
+        const mp_obj_type_t *type = mp_obj_get_type(pattern);
+        size_t i;
+        mp_obj_t compiled;
+        for (i = 0; i < MICROPY_PY_RE_CACHE_SIZE * 2; i += 2) {
+            if (cache[i] == MP_OBJ_NULL) {
+                break;
+            }
+            if (cache[i] == pattern
+                || (mp_obj_get_type(cache[i]) == type && mp_obj_str_equal(cache[i], pattern))) {
+                break;
+            }
+        }
+        if (i < MICROPY_PY_RE_CACHE_SIZE * 2 && cache[i] != MP_OBJ_NULL) {
+            compiled = cache[i + 1];
+        } else {
+            compiled = mod_re_compile(1, &pattern);
+            if (i == MICROPY_PY_RE_CACHE_SIZE * 2) {
+                // Evict the least recently used entry
+                i -= 2;
+            }
+        }
+        // Move the entry to the front
+        memmove(cache + 2, cache, i * sizeof(mp_obj_t));
+        cache[0] = pattern;
+        cache[1] = compiled;
+        return MP_OBJ_TO_PTR(compiled);
+    }
+    #endif
+    return MP_OBJ_TO_PTR(mod_re_compile(1, &pattern));
+}
+
 static void match_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     (void)kind;
     mp_obj_match_t *self = MP_OBJ_TO_PTR(self_in);
@@ -200,7 +247,8 @@ static mp_obj_t re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     if (mp_obj_is_type(args[0], (mp_obj_type_t *)&re_type)) {
         self = MP_OBJ_TO_PTR(args[0]);
     } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
+        // CIRCUITPY-CHANGE
+        self = re_compile_cached(args[0]);
     }
     Subject subj;
     size_t len;
@@ -241,7 +289,11 @@ static mp_obj_t re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, caps, char *, caps_num);
     // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
     memset((char *)match->caps, 0, caps_num * sizeof(char *));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
+    // CIRCUITPY-CHANGE
+    size_t work_size;
+    void *work = re_work_new(self, caps_num, &work_size);
+    int res = re1_5_pikevm(&self->re, &subj, match->caps, caps_num, is_anchored, work);
+    m_del(char, work, work_size);
     if (res == 0) {
         m_del_var(mp_obj_match_t, caps, char *, caps_num, match);
         return mp_const_none;
@@ -279,10 +331,13 @@ static mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
 
     mp_obj_t retval = mp_obj_new_list(0, NULL);
     const char **caps = mp_local_alloc(caps_num * sizeof(char *));
+    // CIRCUITPY-CHANGE
+    size_t work_size;
+    void *work = re_work_new(self, caps_num, &work_size);
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char **)caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = re1_5_pikevm(&self->re, &subj, caps, caps_num, false, work);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -301,6 +356,7 @@ static mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     }
     // cast is a workaround for a bug in msvc (see above)
     mp_local_free((char **)caps);
+    m_del(char, work, work_size);
 
     mp_obj_t s = mp_obj_new_str_of_type(str_type, (const byte *)subj.begin, subj.end - subj.begin);
     mp_obj_list_append(retval, s);
@@ -315,7 +371,8 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     if (mp_obj_is_type(args[0], (mp_obj_type_t *)&re_type)) {
         self = MP_OBJ_TO_PTR(args[0]);
     } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
+        // CIRCUITPY-CHANGE
+        self = re_compile_cached(args[0]);
     }
     mp_obj_t replace = args[1];
     mp_obj_t where = args[2];
@@ -338,11 +395,14 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     match->base.type = (mp_obj_type_t *)&match_type;
     match->num_matches = caps_num / 2; // caps_num counts start and end pointers
     match->str = where;
+    // CIRCUITPY-CHANGE
+    size_t work_size;
+    void *work = re_work_new(self, caps_num, &work_size);
 
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char *)match->caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = re1_5_pikevm(&self->re, &subj, match->caps, caps_num, false, work);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -411,6 +471,7 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     }
 
     mp_local_free(match);
+    m_del(char, work, work_size);
 
     if (vstr_return.buf == NULL) {
         // Optimisation for case of no substitutions
@@ -510,7 +571,8 @@ MP_REGISTER_EXTENSIBLE_MODULE(MP_QSTR_re, mp_module_re);
 #define re1_5_fatal(x) assert(!x)
 
 #include "lib/re1.5/compilecode.c"
-#include "lib/re1.5/recursiveloop.c"
+// CIRCUITPY-CHANGE
+#include "lib/re1.5/pikevm.c"
 #include "lib/re1.5/charclass.c"
 
 #if MICROPY_PY_RE_DEBUG
@@ -29,6 +29,8 @@
 #include "py/runtime.h"
 #include "py/obj.h"
 #include "py/objlist.h"
+// CIRCUITPY-CHANGE
+#include "py/objtype.h"
 #include "py/stream.h"
 #include "py/mperrno.h"
 #include "py/mphal.h"
@@ -64,6 +66,52 @@
 // Flags for ipoll()
 #define FLAG_ONESHOT (1)
 
+// CIRCUITPY-CHANGE
+// The streams most recently passed to mp_stream_poll_notify(), possibly from
+// interrupts.  poll_notify_count is the total number signalled so far, so
+// stream number n is in poll_notify_ring[n % POLL_NOTIFY_RING_SIZE] until
+// POLL_NOTIFY_RING_SIZE more have been signalled.  The pointers are only
+// compared, never dereferenced, so streams freed since are harmless.
+#define POLL_NOTIFY_RING_SIZE (8)
+static mp_obj_t poll_notify_ring[POLL_NOTIFY_RING_SIZE];
+static volatile uint32_t poll_notify_count;
+
+// Returned by poll_notify_take() when streams it no longer remembers were signalled.
+#define POLL_NOTIFY_LOST ((size_t)-1)
+
+void mp_stream_poll_notify(mp_obj_t stream) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    poll_notify_ring[poll_notify_count % POLL_NOTIFY_RING_SIZE] = stream;
+    poll_notify_count++;
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+// Copies the streams signalled since *count to streams, leaving out
+// duplicates, and updates *count.  Returns how many were copied, or
+// POLL_NOTIFY_LOST if some have already been overwritten.
+static size_t poll_notify_take(uint32_t *count, mp_obj_t *streams) {
+    size_t n = 0;
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    uint32_t new_count = poll_notify_count;
+    if (new_count - *count > POLL_NOTIFY_RING_SIZE) {
+        n = POLL_NOTIFY_LOST;
+    } else {
+        for (uint32_t c = *count; c != new_count; c++) {
+            mp_obj_t stream = poll_notify_ring[c % POLL_NOTIFY_RING_SIZE];
+            size_t i = 0;
+            while (i < n && streams[i] != stream) {
+                i++;
+            }
+            if (i == n) {
+                streams[n++] = stream;
+            }
+        }
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    *count = new_count;
+    return n;
+}
+
 // A single pollable object.
 typedef struct _poll_obj_t {
     mp_obj_t obj;
@@ -82,6 +130,8 @@ typedef struct _poll_obj_t {
     mp_uint_t events;
     mp_uint_t revents;
     #endif
+    // CIRCUITPY-CHANGE: events the object signals with mp_stream_poll_notify()
+    mp_uint_t notify_events;
 } poll_obj_t;
 
 // A set of pollable objects.
@@ -89,6 +139,10 @@ typedef struct _poll_set_t {
     // Map containing a dict with key=object to poll, value=its corresponding poll_obj_t.
     mp_map_t map;
 
+    // CIRCUITPY-CHANGE: number of objects without a file descriptor that don't
+    // signal every event they wait for, as counted by the last full pass
+    size_t n_unsignalled;
+
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
     // Array of pollfd entries for objects that have a file descriptor.
     unsigned short alloc; // memory allocated for pollfds
@@ -100,6 +154,8 @@ typedef struct _poll_set_t {
 
 static void poll_set_init(poll_set_t *poll_set, size_t n) {
     mp_map_init(&poll_set->map, n);
+    // CIRCUITPY-CHANGE
+    poll_set->n_unsignalled = 0;
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
     poll_set->alloc = 0;
     poll_set->max_used = 0;
@@ -273,6 +329,17 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
             poll_obj->ioctl = stream_p->ioctl;
             #endif
 
+            // CIRCUITPY-CHANGE: ask native streams which events they signal.
+            // Python streams might answer any request with 0, so aren't asked.
+            poll_obj->notify_events = 0;
+            if (poll_obj->ioctl != NULL && !mp_obj_is_instance_type(mp_obj_get_type(obj[i]))) {
+                int err;
+                mp_uint_t res = poll_obj->ioctl(obj[i], MP_STREAM_POLL_NOTIFIES, 0, &err);
+                if (res != MP_STREAM_ERROR) {
+                    poll_obj->notify_events = res;
+                }
+            }
+
             poll_obj_set_events(poll_obj, events);
             poll_obj_set_revents(poll_obj, 0);
             elem->value = MP_OBJ_FROM_PTR(poll_obj);
@@ -291,9 +358,80 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
     }
 }
 
+// CIRCUITPY-CHANGE
+// Whether the object signals all the events it waits for, including ERR and
+// HUP which are always reported, so only has to be polled when signalled.
+static bool poll_obj_is_signalled(poll_obj_t *poll_obj) {
+    return ((poll_obj_get_events(poll_obj) | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP) & ~poll_obj->notify_events) == 0;
+}
+
+// CIRCUITPY-CHANGE: poll a single object, returning 1 if it is ready.
+static mp_uint_t poll_obj_poll_once(poll_obj_t *poll_obj, size_t *rwx_num) {
+    int errcode;
+    mp_int_t ret = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL, poll_obj_get_events(poll_obj), &errcode);
+    poll_obj_set_revents(poll_obj, ret);
+
+    if (ret == -1) {
+        // error doing ioctl
+        mp_raise_OSError(errcode);
+    }
+
+    if (ret == 0) {
+        return 0;
+    }
+
+    // object is ready
+    #if MICROPY_PY_SELECT_SELECT
+    if (rwx_num != NULL) {
+        if (ret & MP_STREAM_POLL_RD) {
+            rwx_num[0] += 1;
+        }
+        if (ret & MP_STREAM_POLL_WR) {
+            rwx_num[1] += 1;
+        }
+        if ((ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
+            rwx_num[2] += 1;
+        }
+    }
+    #else
+    (void)rwx_num;
+    #endif
+    return 1;
+}
+
 // For each object in the poll set, poll it once.
-static mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
+// CIRCUITPY-CHANGE: if notified isn't NULL, objects that signal all the events
+// they wait for are only polled if they are among the n_notified streams
+// signalled since the last pass, because they weren't ready then.  Otherwise
+// all objects are polled, and the ones that have to be polled on every pass
+// are counted.
+static mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num, const mp_obj_t *notified, size_t n_notified) {
     mp_uint_t n_ready = 0;
+
+    // CIRCUITPY-CHANGE
+    if (notified != NULL) {
+        for (size_t i = 0; i < n_notified; i++) {
+            mp_map_elem_t *elem = mp_map_lookup(&poll_set->map, mp_obj_id(notified[i]), MP_MAP_LOOKUP);
+            if (elem == NULL || elem->value == MP_OBJ_NULL) {
+                continue;
+            }
+            poll_obj_t *poll_obj = MP_OBJ_TO_PTR(elem->value);
+            #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
+            if (poll_obj->pollfd != NULL) {
+                continue;
+            }
+            #endif
+            if (poll_obj_is_signalled(poll_obj)) {
+                n_ready += poll_obj_poll_once(poll_obj, rwx_num);
+            }
+        }
+        if (poll_set->n_unsignalled == 0) {
+            return n_ready;
+        }
+    } else {
+        poll_set->n_unsignalled = 0;
+    }
+
     for (mp_uint_t i = 0; i < poll_set->map.alloc; ++i) {
         if (!mp_map_slot_is_filled(&poll_set->map, i)) {
             continue;
@@ -308,34 +446,16 @@ static mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
         }
         #endif
 
-        int errcode;
-        mp_int_t ret = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL, poll_obj_get_events(poll_obj), &errcode);
-        poll_obj_set_revents(poll_obj, ret);
-
-        if (ret == -1) {
-            // error doing ioctl
-            mp_raise_OSError(errcode);
-        }
-
-        if (ret != 0) {
-            // object is ready
-            n_ready += 1;
-            #if MICROPY_PY_SELECT_SELECT
-            if (rwx_num != NULL) {
-                if (ret & MP_STREAM_POLL_RD) {
-                    rwx_num[0] += 1;
-                }
-                if (ret & MP_STREAM_POLL_WR) {
-                    rwx_num[1] += 1;
-                }
-                if ((ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
-                    rwx_num[2] += 1;
-                }
+        // CIRCUITPY-CHANGE
+        if (!poll_obj_is_signalled(poll_obj)) {
+            if (notified == NULL) {
+                poll_set->n_unsignalled++;
             }
-            #else
-            (void)rwx_num;
-            #endif
+        } else if (notified != NULL) {
+            continue;
         }
+
+        n_ready += poll_obj_poll_once(poll_obj, rwx_num);
     }
     return n_ready;
 }
@@ -344,6 +464,12 @@ static mp_uint_t poll_set_poll_until_ready_or_timeout(poll_set_t *poll_set, size
     mp_uint_t start_ticks = mp_hal_ticks_ms();
     bool has_timeout = timeout != (mp_uint_t)-1;
 
+    // CIRCUITPY-CHANGE: the first pass polls every object.  After that,
+    // objects that signal readiness are only polled again once signalled.
+    uint32_t notify_count = poll_notify_count;
+    mp_obj_t notified[POLL_NOTIFY_RING_SIZE];
+    size_t n_notified = POLL_NOTIFY_LOST;
+
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
 
     for (;;) {
@@ -383,7 +509,7 @@ static mp_uint_t poll_set_poll_until_ready_or_timeout(poll_set_t *poll_set, size
 
         // Explicitly poll any objects that do not have a file descriptor.
         if (!poll_set_all_are_fds(poll_set)) {
-            n_ready += poll_set_poll_once(poll_set, rwx_num);
+            n_ready += poll_set_poll_once(poll_set, rwx_num, n_notified == POLL_NOTIFY_LOST ? NULL : notified, n_notified);
         }
 
         // Return if an object is ready, or if the timeout expired.
@@ -393,13 +519,16 @@ static mp_uint_t poll_set_poll_until_ready_or_timeout(poll_set_t *poll_set, size
 
         // This would be mp_event_wait_ms() but the call to poll() above already includes a delay.
         mp_event_handle_nowait();
+
+        // CIRCUITPY-CHANGE
+        n_notified = poll_notify_take(&notify_count, notified);
     }
 
     #else
 
     for (;;) {
         // poll the objects
-        mp_uint_t n_ready = poll_set_poll_once(poll_set, rwx_num);
+        mp_uint_t n_ready = poll_set_poll_once(poll_set, rwx_num, n_notified == POLL_NOTIFY_LOST ? NULL : notified, n_notified);
         uint32_t elapsed = mp_hal_ticks_ms() - start_ticks;
         if (n_ready > 0 || (has_timeout && elapsed >= timeout)) {
             return n_ready;
@@ -414,6 +543,8 @@ static mp_uint_t poll_set_poll_until_ready_or_timeout(poll_set_t *poll_set, size
         } else {
             mp_event_wait_indefinite();
         }
+        // CIRCUITPY-CHANGE
+        n_notified = poll_notify_take(&notify_count, notified);
     }
 
     #endif
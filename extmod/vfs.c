@@ -125,7 +125,8 @@ static mp_obj_t mp_vfs_proxy_call(mp_vfs_mount_t *vfs, qstr meth_name, size_t n_
     return mp_call_method_n_kw(n_args, 0, meth);
 }
 
-mp_import_stat_t mp_vfs_import_stat(const char *path) {
+// CIRCUITPY-CHANGE: renamed so that mp_vfs_import_stat can consult the cache first
+static mp_import_stat_t import_stat_uncached(const char *path) {
     const char *path_out;
     mp_vfs_mount_t *vfs = mp_vfs_lookup_path(path, &path_out);
     if (vfs == MP_VFS_NONE || vfs == MP_VFS_ROOT) {
@@ -160,6 +161,162 @@ mp_import_stat_t mp_vfs_import_stat(const char *path) {
     }
 }
 
+// CIRCUITPY-CHANGE: cache directory listings for import
+#if MICROPY_VFS_IMPORT_STAT_CACHE
+
+// Resolving an import probes "<dir>/<name>", "<dir>/<name>.py" and
+// "<dir>/<name>.mpy" for every sys.path entry, and on FAT each probe is a
+// walk of the directory.  Instead, each directory that import looks in is
+// listed once into a blob of (type byte, name, '\0') entries, kept in a dict
+// keyed by the directory path, and the probes are answered from that.  The
+// whole cache is dropped by mp_vfs_import_stat_cache_invalidate() whenever
+// the filesystem or the mount table may have changed, both here and in the
+// FAT and littlefs methods so that calling those directly is also seen.
+
+// Entry type for anything that is neither a regular file nor a directory
+// (eg a symlink), which must be stat'ed to find out what it points to.
+#define IMPORT_STAT_CACHE_UNKNOWN (3)
+// Returned by import_stat_cache_find when the listing can't answer: the entry
+// has an unknown type, or only a case-insensitive match exists, which FAT
+// accepts and POSIX doesn't.
+#define IMPORT_STAT_CACHE_UNSURE (4)
+
+void mp_vfs_import_stat_cache_invalidate(void) {
+    MP_STATE_VM(vfs_import_stat_cache) = MP_OBJ_NULL;
+}
+
+// Returns the listing blob for dir, or None if dir can't be listed (eg a
+// user filesystem without ilistdir) and every path in it must be stat'ed.
+static mp_obj_t import_stat_cache_list_dir(mp_obj_t dir) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        vstr_t vstr;
+        vstr_init(&vstr, 64);
+        mp_obj_t iter = mp_vfs_ilistdir(1, &dir);
+        mp_obj_t next;
+        while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+            size_t n;
+            mp_obj_t *items;
+            mp_obj_get_array(next, &n, &items);
+            size_t name_len;
+            const char *name = mp_obj_str_get_data(items[0], &name_len);
+            mp_int_t mode = n > 1 ? mp_obj_get_int(items[1]) & 0xf000 : 0;
+            if (mode == MP_S_IFDIR) {
+                vstr_add_byte(&vstr, MP_IMPORT_STAT_DIR);
+            } else if (mode == MP_S_IFREG) {
+                vstr_add_byte(&vstr, MP_IMPORT_STAT_FILE);
+            } else {
+                vstr_add_byte(&vstr, IMPORT_STAT_CACHE_UNKNOWN);
+            }
+            vstr_add_strn(&vstr, name, name_len);
+            vstr_add_byte(&vstr, '\0');
+        }
+        nlr_pop();
+        return mp_obj_new_bytes_from_vstr(&vstr);
+    } else {
+        const mp_obj_type_t *type = ((mp_obj_base_t *)nlr.ret_val)->type;
+        if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(type), MP_OBJ_FROM_PTR(&mp_type_Exception))) {
+            // Don't swallow KeyboardInterrupt, reloads and the like.
+            nlr_jump(nlr.ret_val);
+        }
+        if (mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(type), MP_OBJ_FROM_PTR(&mp_type_OSError))) {
+            // The directory doesn't exist (or isn't one), so nothing is in it.
+            return mp_const_empty_bytes;
+        }
+        return mp_const_none;
+    }
+}
+
+static int import_stat_cache_find(mp_obj_t listing, const char *name, size_t name_len) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(listing, &bufinfo, MP_BUFFER_READ);
+    const byte *entry = bufinfo.buf;
+    const byte *top = entry + bufinfo.len;
+    int result = MP_IMPORT_STAT_NO_EXIST;
+    while (entry < top) {
+        const char *entry_name = (const char *)entry + 1;
+        size_t entry_len = strlen(entry_name);
+        if (entry_len == name_len) {
+            if (memcmp(entry_name, name, name_len) == 0) {
+                return entry[0] == IMPORT_STAT_CACHE_UNKNOWN ? IMPORT_STAT_CACHE_UNSURE : entry[0];
+            }
+            size_t i = 0;
+            while (i < name_len && unichar_tolower((byte)entry_name[i]) == unichar_tolower((byte)name[i])) {
+                ++i;
+            }
+            if (i == name_len) {
+                result = IMPORT_STAT_CACHE_UNSURE;
+            }
+        }
+        entry += 1 + entry_len + 1;
+    }
+    return result;
+}
+
+mp_import_stat_t mp_vfs_import_stat(const char *path) {
+    const char *name = strrchr(path, '/');
+    size_t dir_len = 0;
+    if (name == NULL) {
+        name = path;
+    } else {
+        // Keep the slash if the directory is the root.
+        dir_len = name == path ? 1 : name - path;
+        ++name;
+    }
+    if (*name == '\0') {
+        return import_stat_uncached(path);
+    }
+
+    // Only use a listing if both the directory and the path itself are on
+    // the same mounted filesystem; a path that is itself a mount point won't
+    // show up in the listing of its parent.
+    mp_obj_t dir = mp_obj_new_str(path, dir_len);
+    const char *path_out;
+    mp_vfs_mount_t *vfs = mp_vfs_lookup_path(mp_obj_str_get_str(dir), &path_out);
+    if (vfs == MP_VFS_NONE || vfs == MP_VFS_ROOT || mp_vfs_lookup_path(path, &path_out) != vfs) {
+        return import_stat_uncached(path);
+    }
+    #if defined(MICROPY_VFS_POSIX) && MICROPY_VFS_POSIX
+    // Other processes can change a host directory behind our back, and stat
+    // there is cheap anyway, so never cache it.
+    if (mp_obj_is_type(vfs->obj, &mp_type_vfs_posix)) {
+        return import_stat_uncached(path);
+    }
+    #endif
+
+    // Hold the cache locally, it may be invalidated while listing the directory.
+    mp_obj_t cache = MP_STATE_VM(vfs_import_stat_cache);
+    if (cache == MP_OBJ_NULL) {
+        cache = mp_obj_new_dict(0);
+        MP_STATE_VM(vfs_import_stat_cache) = cache;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(cache), dir, MP_MAP_LOOKUP);
+    mp_obj_t listing;
+    if (elem != NULL) {
+        listing = elem->value;
+    } else {
+        listing = import_stat_cache_list_dir(dir);
+        mp_obj_dict_store(cache, dir, listing);
+    }
+    if (listing != mp_const_none) {
+        int stat = import_stat_cache_find(listing, name, strlen(name));
+        if (stat != IMPORT_STAT_CACHE_UNSURE) {
+            return stat;
+        }
+    }
+    return import_stat_uncached(path);
+}
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t vfs_import_stat_cache);
+
+#else
+
+mp_import_stat_t mp_vfs_import_stat(const char *path) {
+    return import_stat_uncached(path);
+}
+
+#endif
+
 static mp_obj_t mp_vfs_autodetect(mp_obj_t bdev_obj) {
     #if MICROPY_VFS_LFS1 || MICROPY_VFS_LFS2
     nlr_buf_t nlr;
@@ -249,6 +406,9 @@ mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
         }
     }
 
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
+
     // insert the vfs into the mount table
     mp_vfs_mount_t **vfsp = &MP_STATE_VM(vfs_mount_table);
     while (*vfsp != NULL) {
@@ -285,6 +445,9 @@ mp_obj_t mp_vfs_umount(mp_obj_t mnt_in) {
         mp_raise_OSError(MP_EINVAL);
     }
 
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
+
     // if we unmounted the current device then set current to root
     if (MP_STATE_VM(vfs_cur) == vfs) {
         MP_STATE_VM(vfs_cur) = MP_VFS_ROOT;
@@ -320,6 +483,10 @@ mp_obj_t mp_vfs_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
     #endif
 
     mp_vfs_mount_t *vfs = lookup_path(args[ARG_file].u_obj, &args[ARG_file].u_obj);
+    // CIRCUITPY-CHANGE: opening for writing may create the file
+    if (mp_obj_is_str(args[ARG_mode].u_obj) && strpbrk(mp_obj_str_get_str(args[ARG_mode].u_obj), "wax+") != NULL) {
+        mp_vfs_import_stat_cache_invalidate();
+    }
     return mp_vfs_proxy_call(vfs, MP_QSTR_open, 2, (mp_obj_t *)&args);
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mp_vfs_open_obj, 0, mp_vfs_open);
@@ -327,6 +494,8 @@ MP_DEFINE_CONST_FUN_OBJ_KW(mp_vfs_open_obj, 0, mp_vfs_open);
 mp_obj_t mp_vfs_chdir(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    // CIRCUITPY-CHANGE: relative paths are cached by name
+    mp_vfs_import_stat_cache_invalidate();
     if (vfs == MP_VFS_ROOT) {
         // If we change to the root dir and a VFS is mounted at the root then
         // we must change that VFS's current dir to the root dir so that any
@@ -442,6 +611,8 @@ mp_obj_t mp_vfs_mkdir(mp_obj_t path_in) {
     if (vfs == MP_VFS_ROOT || (vfs != MP_VFS_NONE && !strcmp(mp_obj_str_get_str(path_out), "/"))) {
         mp_raise_OSError(MP_EEXIST);
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
     return mp_vfs_proxy_call(vfs, MP_QSTR_mkdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
@@ -449,6 +620,8 @@ MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
 mp_obj_t mp_vfs_remove(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
     return mp_vfs_proxy_call(vfs, MP_QSTR_remove, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_remove_obj, mp_vfs_remove);
@@ -461,6 +634,8 @@ mp_obj_t mp_vfs_rename(mp_obj_t old_path_in, mp_obj_t new_path_in) {
         // can't rename across filesystems
         mp_raise_OSError(MP_EPERM);
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
     return mp_vfs_proxy_call(old_vfs, MP_QSTR_rename, 2, args);
 }
 MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
@@ -468,6 +643,8 @@ MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
 mp_obj_t mp_vfs_rmdir(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_stat_cache_invalidate();
     return mp_vfs_proxy_call(vfs, MP_QSTR_rmdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_rmdir_obj, mp_vfs_rmdir);
@@ -116,6 +116,13 @@ mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t
 
 mp_vfs_mount_t *mp_vfs_lookup_path(const char *path, const char **path_out);
 mp_import_stat_t mp_vfs_import_stat(const char *path);
+// CIRCUITPY-CHANGE: call after anything that may change a directory or the mount table
+#if MICROPY_VFS_IMPORT_STAT_CACHE
+void mp_vfs_import_stat_cache_invalidate(void);
+#else
+static inline void mp_vfs_import_stat_cache_invalidate(void) {
+}
+#endif
 mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 mp_obj_t mp_vfs_umount(mp_obj_t mnt_in);
 mp_obj_t mp_vfs_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
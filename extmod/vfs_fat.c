@@ -243,6 +243,8 @@ static mp_obj_t fat_vfs_remove_internal(mp_obj_t vfs_in, mp_obj_t path_in, mp_in
             // CIRCUITPY-CHANGE
             mp_raise_OSError_fresult(res);
         }
+        // CIRCUITPY-CHANGE: drop cached import listings
+        mp_vfs_import_stat_cache_invalidate();
         return mp_const_none;
     } else {
         mp_raise_OSError(attr ? MP_ENOTDIR : MP_EISDIR);
@@ -273,6 +275,8 @@ static mp_obj_t fat_vfs_rename(mp_obj_t vfs_in, mp_obj_t path_in, mp_obj_t path_
         res = f_rename(&self->fatfs, old_path, new_path);
     }
     if (res == FR_OK) {
+        // CIRCUITPY-CHANGE: drop cached import listings
+        mp_vfs_import_stat_cache_invalidate();
         return mp_const_none;
     } else {
         // CIRCUITPY-CHANGE
@@ -288,6 +292,8 @@ static mp_obj_t fat_vfs_mkdir(mp_obj_t vfs_in, mp_obj_t path_o) {
     const char *path = mp_obj_str_get_str(path_o);
     FRESULT res = f_mkdir(&self->fatfs, path);
     if (res == FR_OK) {
+        // CIRCUITPY-CHANGE: drop cached import listings
+        mp_vfs_import_stat_cache_invalidate();
         return mp_const_none;
     } else {
         // CIRCUITPY-CHANGE
@@ -308,6 +314,8 @@ static mp_obj_t fat_vfs_chdir(mp_obj_t vfs_in, mp_obj_t path_in) {
         // CIRCUITPY-CHANGE
         mp_raise_OSError_fresult(res);
     }
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
 
     return mp_const_none;
 }
@@ -259,6 +259,10 @@ static mp_obj_t fat_vfs_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode_i
         m_del_obj(pyb_file_obj_t, o);
         mp_raise_OSError_errno_str(fresult_to_errno_table[res], path_in);
     }
+    // CIRCUITPY-CHANGE: opening for writing may have created the file
+    if (mode & FA_WRITE) {
+        mp_vfs_import_stat_cache_invalidate();
+    }
     // CIRCUITPY-CHANGE: does fast seek.
     // If we're reading, turn on fast seek.
     if (mode == FA_READ) {
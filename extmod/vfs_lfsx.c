@@ -245,6 +245,8 @@ static mp_obj_t MP_VFS_LFSx(remove)(mp_obj_t self_in, mp_obj_t path_in) {
     if (ret < 0) {
         mp_raise_OSError(-ret);
     }
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(MP_VFS_LFSx(remove_obj), MP_VFS_LFSx(remove));
@@ -256,6 +258,8 @@ static mp_obj_t MP_VFS_LFSx(rmdir)(mp_obj_t self_in, mp_obj_t path_in) {
     if (ret < 0) {
         mp_raise_OSError(-ret);
     }
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(MP_VFS_LFSx(rmdir_obj), MP_VFS_LFSx(rmdir));
@@ -275,6 +279,8 @@ static mp_obj_t MP_VFS_LFSx(rename)(mp_obj_t self_in, mp_obj_t path_old_in, mp_o
     if (ret < 0) {
         mp_raise_OSError(-ret);
     }
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_3(MP_VFS_LFSx(rename_obj), MP_VFS_LFSx(rename));
@@ -286,6 +292,8 @@ static mp_obj_t MP_VFS_LFSx(mkdir)(mp_obj_t self_in, mp_obj_t path_o) {
     if (ret < 0) {
         mp_raise_OSError(-ret);
     }
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(MP_VFS_LFSx(mkdir_obj), MP_VFS_LFSx(mkdir));
@@ -354,6 +362,9 @@ static mp_obj_t MP_VFS_LFSx(chdir)(mp_obj_t self_in, mp_obj_t path_in) {
         }
     }
 
+    // CIRCUITPY-CHANGE: drop cached import listings
+    mp_vfs_import_stat_cache_invalidate();
+
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(MP_VFS_LFSx(chdir_obj), MP_VFS_LFSx(chdir));
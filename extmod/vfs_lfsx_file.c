@@ -118,6 +118,10 @@ mp_obj_t MP_VFS_LFSx(file_open)(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mod
         o->vfs = NULL;
         mp_raise_OSError(-ret);
     }
+    // CIRCUITPY-CHANGE: opening for writing may have created the file
+    if (flags != LFSx_MACRO(_O_RDONLY)) {
+        mp_vfs_import_stat_cache_invalidate();
+    }
 
     return MP_OBJ_FROM_PTR(o);
 }
@@ -85,6 +85,24 @@ void mp_reader_new_file(mp_reader_t *reader, qstr filename) {
 
     const mp_stream_p_t *stream_p = mp_get_stream(file);
     int errcode = 0;
+
+    // CIRCUITPY-CHANGE: a .mpy file whose data the filesystem can keep in memory
+    // for the life of the VM is read, and may be referenced, in place
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    size_t name_len;
+    const char *name = (const char *)qstr_data(filename, &name_len);
+    if (name_len > 4 && memcmp(name + name_len - 4, ".mpy", 4) == 0) {
+        const void *data = NULL;
+        mp_uint_t len = stream_p->ioctl(file, MP_STREAM_GET_BUFFER_PTR, (uintptr_t)&data, &errcode);
+        if (len != MP_STREAM_ERROR && data != NULL) {
+            mp_stream_close(file);
+            mp_reader_new_mem(reader, data, len, MP_READER_IS_ROM);
+            return;
+        }
+        errcode = 0;
+    }
+    #endif
+
     mp_uint_t bufsize = stream_p->ioctl(file, MP_STREAM_GET_BUFFER_SIZE, 0, &errcode);
     if (bufsize == MP_STREAM_ERROR || bufsize == 0) {
         // bufsize == 0 is included here to support mpremote v1.21 and older where mount file ioctl
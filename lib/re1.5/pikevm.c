@@ -0,0 +1,210 @@
+// Copyright 2007-2009 Russ Cox.  All Rights Reserved.
+// Copyright 2014 Paul Sokolovsky.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// CIRCUITPY-CHANGE: Pike VM over ByteProg with caller-supplied memory.
+//
+// All candidate threads advance over the subject in lock step, so a match
+// costs O(len(subject) * prog->len) and never recurses.  Threads are kept
+// in priority order and lower priority threads are cut off once a thread
+// matches, which gives the same leftmost-first result (including captures)
+// as the backtracking engines.  The thread lists are bounded by the number
+// of instructions; re1_5_pikevm_worksize() gives the size of the work area.
+
+#include "re1.5.h"
+
+typedef struct PikeThreadList PikeThreadList;
+typedef struct PikeStackEntry PikeStackEntry;
+typedef struct PikeVM PikeVM;
+
+struct PikeThreadList
+{
+	int n;
+	const char **pc;
+	const char **sub;	// nsubp capture slots per thread
+};
+
+struct PikeStackEntry
+{
+	const char *pc;	// nil: restore cur[slot] to old
+	const char *old;
+	int slot;
+};
+
+struct PikeVM
+{
+	ByteProg *prog;
+	Subject *input;
+	int nsubp;
+	PikeThreadList list[2];
+	PikeStackEntry *stack;
+	const char **cur;
+	uint16_t *mark;
+	uint16_t gen;
+};
+
+int
+re1_5_pikevm_worksize(ByteProg *prog, int nsubp)
+{
+	return 2 * prog->len * (1 + nsubp) * sizeof(const char*)
+		+ (prog->len + 1) * sizeof(PikeStackEntry)
+		+ nsubp * sizeof(const char*)
+		+ prog->bytelen * sizeof(uint16_t);
+}
+
+static void
+nextgen(PikeVM *vm)
+{
+	if(++vm->gen == 0) {
+		memset(vm->mark, 0, vm->prog->bytelen * sizeof(uint16_t));
+		vm->gen = 1;
+	}
+}
+
+// Follow all non-consuming instructions reachable from pc at position sp,
+// appending the consuming (and Match) instructions reached to l in priority
+// order.  sub holds the captures of the thread being extended.
+static void
+addthread(PikeVM *vm, PikeThreadList *l, const char *pc, const char *sp, const char **sub)
+{
+	PikeStackEntry *stack = vm->stack;
+	const char **cur = vm->cur;
+	int nsubp = vm->nsubp;
+	int n = 0;
+	int off;
+
+	memcpy(cur, sub, nsubp * sizeof(const char*));
+	stack[n++].pc = pc;
+	while(n > 0) {
+		PikeStackEntry *e = &stack[--n];
+		if(e->pc == nil) {
+			cur[e->slot] = e->old;
+			continue;
+		}
+		pc = e->pc;
+		for(;;) {
+			off = pc - vm->prog->insts;
+			if(vm->mark[off] == vm->gen)
+				break;
+			vm->mark[off] = vm->gen;
+			switch(*pc) {
+			case Jmp:
+				pc = pc + 2 + (signed char)pc[1];
+				continue;
+			case Split:
+				stack[n++].pc = pc + 2 + (signed char)pc[1];
+				pc += 2;
+				continue;
+			case RSplit:
+				stack[n++].pc = pc + 2;
+				pc = pc + 2 + (signed char)pc[1];
+				continue;
+			case Save:
+				off = (unsigned char)pc[1];
+				pc += 2;
+				if(off < nsubp) {
+					stack[n].pc = nil;
+					stack[n].old = cur[off];
+					stack[n++].slot = off;
+					cur[off] = sp;
+				}
+				continue;
+			case Bol:
+				if(sp != vm->input->begin_line)
+					break;
+				pc++;
+				continue;
+			case Eol:
+				if(sp != vm->input->end)
+					break;
+				pc++;
+				continue;
+			default:
+				l->pc[l->n] = pc;
+				memcpy(l->sub + l->n * nsubp, cur, nsubp * sizeof(const char*));
+				l->n++;
+				break;
+			}
+			break;
+		}
+	}
+}
+
+int
+re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int is_anchored, void *work)
+{
+	PikeVM vm;
+	PikeThreadList *clist, *nlist, *tmp;
+	const char *pc, *sp;
+	const char **sub;
+	int i, matched;
+
+	vm.prog = prog;
+	vm.input = input;
+	vm.nsubp = nsubp;
+	for(i = 0; i < 2; i++) {
+		vm.list[i].pc = work;
+		vm.list[i].sub = vm.list[i].pc + prog->len;
+		work = vm.list[i].sub + prog->len * nsubp;
+	}
+	vm.stack = work;
+	vm.cur = (const char**)(vm.stack + prog->len + 1);
+	vm.mark = (uint16_t*)(vm.cur + nsubp);
+	memset(vm.mark, 0, prog->bytelen * sizeof(uint16_t));
+	vm.gen = 0;
+
+	clist = &vm.list[0];
+	nlist = &vm.list[1];
+	clist->n = 0;
+	nextgen(&vm);
+	addthread(&vm, clist, HANDLE_ANCHORED(prog->insts, is_anchored), input->begin, subp);
+
+	matched = 0;
+	for(sp = input->begin; clist->n > 0; sp++) {
+		nextgen(&vm);
+		nlist->n = 0;
+		for(i = 0; i < clist->n; i++) {
+			pc = clist->pc[i];
+			sub = clist->sub + i * nsubp;
+			if(*pc == Match) {
+				// Lower priority threads can't win any more
+				memcpy(subp, sub, nsubp * sizeof(const char*));
+				matched = 1;
+				break;
+			}
+			if(sp >= input->end)
+				continue;
+			switch(*pc) {
+			case Char:
+				if(*sp != pc[1])
+					continue;
+				pc += 2;
+				break;
+			case Any:
+				pc++;
+				break;
+			case Class:
+			case ClassNot:
+				if(!_re1_5_classmatch(pc + 1, sp))
+					continue;
+				pc += (unsigned char)pc[1] * 2 + 2;
+				break;
+			case NamedClass:
+				if(!_re1_5_namedclassmatch(pc + 1, sp))
+					continue;
+				pc += 2;
+				break;
+			default:
+				re1_5_fatal("pikevm");
+			}
+			addthread(&vm, nlist, pc, sp + 1, sub);
+		}
+		if(sp >= input->end)
+			break;
+		tmp = clist;
+		clist = nlist;
+		nlist = tmp;
+	}
+	return matched;
+}
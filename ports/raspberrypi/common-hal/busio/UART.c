@@ -80,17 +80,33 @@ static uint8_t pin_init(const uint8_t uart, const mcu_pin_obj_t *pin, const uint
 
 static busio_uart_obj_t *active_uarts[NUM_UARTS];
 
-static void _copy_into_ringbuf(ringbuf_t *r, uart_inst_t *uart) {
-    while (uart_is_readable(uart) && ringbuf_num_empty(r) > 0) {
-        ringbuf_put(r, (uint8_t)uart_get_hw(uart)->dr);
+// Only call this from the irq handler or with the irq disabled: it is the
+// ringbuf's single producer.
+static void _copy_into_ringbuf(ringbuf_spsc_t *r, uart_inst_t *uart) {
+    // The free space may be split in two by the end of the buffer.
+    for (int i = 0; i < 2; i++) {
+        size_t space;
+        uint8_t *dest = ringbuf_spsc_write_span(r, &space);
+        size_t n = 0;
+        while (n < space && uart_is_readable(uart)) {
+            dest[n++] = (uint8_t)uart_get_hw(uart)->dr;
+        }
+        ringbuf_spsc_write_commit(r, n);
+        if (n < space || space == 0) {
+            break;
+        }
     }
 }
 
 static void shared_callback(busio_uart_obj_t *self) {
+    bool was_empty = ringbuf_spsc_num_filled(&self->ringbuf) == 0;
     _copy_into_ringbuf(&self->ringbuf, self->uart);
     // We always clear the interrupt so it doesn't continue to fire because we
     // may not have read everything available.
     uart_get_hw(self->uart)->icr = UART_UARTICR_RXIC_BITS | UART_UARTICR_RTIC_BITS;
+    if (was_empty && ringbuf_spsc_num_filled(&self->ringbuf) > 0) {
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(self));
+    }
 }
 
 static void uart0_callback(void) {
@@ -166,9 +182,9 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     if (rx != NULL) {
         // Use the provided buffer when given.
         if (receiver_buffer != NULL) {
-            ringbuf_init(&self->ringbuf, receiver_buffer, receiver_buffer_size);
+            ringbuf_spsc_init(&self->ringbuf, receiver_buffer, receiver_buffer_size);
         } else {
-            if (!ringbuf_alloc(&self->ringbuf, receiver_buffer_size)) {
+            if (!ringbuf_spsc_alloc(&self->ringbuf, receiver_buffer_size)) {
                 uart_deinit(self->uart);
                 m_malloc_fail(receiver_buffer_size);
             }
@@ -196,7 +212,7 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
         return;
     }
     uart_deinit(self->uart);
-    ringbuf_deinit(&self->ringbuf);
+    ringbuf_spsc_deinit(&self->ringbuf);
     active_uarts[self->uart_id] = NULL;
     uart_status[self->uart_id] = STATUS_FREE;
     reset_pin_number(self->tx_pin);
@@ -250,40 +266,41 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
         return 0;
     }
 
-    // Prevent conflict with uart irq.
-    irq_set_enabled(self->uart_irq_id, false);
-
-    // Copy as much received data as available, up to len bytes.
-    size_t total_read = ringbuf_get_n(&self->ringbuf, data, len);
-
-    // Check if we still need to read more data.
-    if (len > total_read) {
-        len -= total_read;
-        uint64_t start_ticks = supervisor_ticks_ms64();
-        // Busy-wait until timeout or until we've read enough chars.
-        while (len > 0 && (supervisor_ticks_ms64() - start_ticks < self->timeout_ms)) {
-            if (uart_is_readable(self->uart)) {
-                // Read and advance.
-                data[total_read] = uart_get_hw(self->uart)->dr;
-
-                // Adjust the counters.
-                len--;
-                total_read++;
-
-                // Reset the timeout on every character read.
-                start_ticks = supervisor_ticks_ms64();
-            }
-            RUN_BACKGROUND_TASKS;
-            // Allow user to break out of a timeout with a KeyboardInterrupt.
-            if (mp_hal_is_interrupted()) {
-                break;
-            }
+    // The irq keeps filling the ringbuf while we drain it, so it stays enabled
+    // here and the FIFO can't overflow during a long read.
+    size_t total_read = 0;
+    uint64_t start_ticks = supervisor_ticks_ms64();
+    // Busy-wait until timeout or until we've read enough chars.
+    for (;;) {
+        size_t n = ringbuf_spsc_get_n(&self->ringbuf, data + total_read, len - total_read);
+        if (n > 0) {
+            total_read += n;
+            // Reset the timeout on every character read.
+            start_ticks = supervisor_ticks_ms64();
+        }
+        if (total_read == len || supervisor_ticks_ms64() - start_ticks >= self->timeout_ms) {
+            break;
+        }
+        // The UART only interrupts after a threshold, so don't wait for the
+        // irq to pick up the last few bytes.
+        if (n == 0 && uart_is_readable(self->uart)) {
+            irq_set_enabled(self->uart_irq_id, false);
+            _copy_into_ringbuf(&self->ringbuf, self->uart);
+            irq_set_enabled(self->uart_irq_id, true);
+            continue;
+        }
+        RUN_BACKGROUND_TASKS;
+        // Allow user to break out of a timeout with a KeyboardInterrupt.
+        if (mp_hal_is_interrupted()) {
+            break;
         }
     }
 
     // Now that we've emptied the ringbuf some, fill it up with anything in the
-    // FIFO. This ensures that we'll empty the FIFO as much as possible and
-    // reset the interrupt when we catch up.
+    // FIFO. The irq stops copying when the ringbuf is full, so this ensures
+    // that we'll empty the FIFO as much as possible and reset the interrupt
+    // when we catch up.
+    irq_set_enabled(self->uart_irq_id, false);
     _copy_into_ringbuf(&self->ringbuf, self->uart);
 
     // Re-enable irq.
@@ -321,13 +338,13 @@ uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
     // out of its FIFO before measuring how many bytes we've received.
     _copy_into_ringbuf(&self->ringbuf, self->uart);
     irq_set_enabled(self->uart_irq_id, true);
-    return ringbuf_num_filled(&self->ringbuf);
+    return ringbuf_spsc_num_filled(&self->ringbuf);
 }
 
 void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
     // Prevent conflict with uart irq.
     irq_set_enabled(self->uart_irq_id, false);
-    ringbuf_clear(&self->ringbuf);
+    ringbuf_spsc_clear(&self->ringbuf);
 
     // Throw away the FIFO contents too.
     while (uart_is_readable(self->uart)) {
@@ -343,6 +360,12 @@ bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
     return uart_is_writable(self->uart);
 }
 
+mp_uint_t common_hal_busio_uart_poll_notifies(busio_uart_obj_t *self) {
+    // shared_callback() signals when it moves bytes into an empty ringbuf.
+    // ERR and HUP are never reported, so they can't be missed.
+    return MP_STREAM_POLL_RD | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP;
+}
+
 static void pin_never_reset(uint8_t pin) {
     if (pin != NO_PIN) {
         never_reset_pin_number(pin);
@@ -197,6 +197,7 @@ static u8_t _lwip_raw_incoming(void *arg, struct raw_pcb *pcb, struct pbuf *p, c
     } else {
         socket->incoming.pbuf = p;
         memcpy(&socket->peer, addr, sizeof(socket->peer));
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
     }
     return 1; // we ate the packet
 }
@@ -219,6 +220,7 @@ static void _lwip_udp_incoming(void *arg, struct udp_pcb *upcb, struct pbuf *p,
         socket->incoming.pbuf = p;
         socket->peer_port = (mp_uint_t)port;
         memcpy(&socket->peer, addr, sizeof(socket->peer));
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
     }
 }
 
@@ -301,6 +303,7 @@ static err_t _lwip_tcp_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
     // Search for an empty slot to store the new connection
     struct tcp_pcb *volatile *slot = &lwip_socket_incoming_array(socket)[socket->incoming.connection.iput];
     if (*slot == NULL) {
+        bool was_empty = lwip_socket_incoming_array(socket)[socket->incoming.connection.iget] == NULL;
         // Have an empty slot to store waiting connection
         *slot = newpcb;
         if (++socket->incoming.connection.iput >= socket->incoming.connection.alloc) {
@@ -309,6 +312,9 @@ static err_t _lwip_tcp_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
 
         // Schedule user accept callback
         exec_user_callback(socket);
+        if (was_empty) {
+            mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
+        }
 
         // Set the error callback to handle the case of a dropped connection before we
         // have a chance to take it off the accept queue.
@@ -329,16 +335,24 @@ static err_t _lwip_tcp_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
 static err_t _lwip_tcp_recv(void *arg, struct tcp_pcb *tcpb, struct pbuf *p, err_t err) {
     socketpool_socket_obj_t *socket = (socketpool_socket_obj_t *)arg;
 
+    bool was_readable = socket->incoming.pbuf != NULL || socket->state == STATE_PEER_CLOSED;
+
     if (p == NULL) {
         // Other side has closed connection.
         DEBUG_printf("_lwip_tcp_recv[%p]: other side closed connection\n", socket);
         socket->state = STATE_PEER_CLOSED;
         exec_user_callback(socket);
+        if (!was_readable) {
+            mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
+        }
         return ERR_OK;
     }
 
     if (socket->incoming.pbuf == NULL) {
         socket->incoming.pbuf = p;
+        if (!was_readable) {
+            mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
+        }
     } else {
         #ifdef SOCKET_SINGLE_PBUF
         return ERR_BUF;
@@ -1253,7 +1267,7 @@ bool common_hal_socketpool_readable(socketpool_socket_obj_t *self) {
 
     if (self->type == SOCKETPOOL_SOCK_STREAM && self->pcb.tcp->state == LISTEN) {
         struct tcp_pcb *volatile *incoming_connection = &lwip_socket_incoming_array(self)[self->incoming.connection.iget];
-        result = (incoming_connection != NULL);
+        result = (*incoming_connection != NULL);
     }
 
     MICROPY_PY_LWIP_EXIT;
@@ -1261,6 +1275,13 @@ bool common_hal_socketpool_readable(socketpool_socket_obj_t *self) {
     return result;
 }
 
+mp_uint_t common_hal_socketpool_socket_poll_notifies(socketpool_socket_obj_t *self) {
+    // The lwIP callbacks signal when a socket becomes readable: a packet or
+    // connection arrives while none is waiting, or the peer closes the
+    // connection.  ERR and HUP are never reported, so they can't be missed.
+    return MP_STREAM_POLL_RD | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP;
+}
+
 bool common_hal_socketpool_writable(socketpool_socket_obj_t *self) {
     bool result = false;
 
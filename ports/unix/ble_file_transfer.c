@@ -0,0 +1,267 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#if defined(MICROPY_UNIX_COVERAGE) && CIRCUITPY_BLE_FILE_SERVICE
+
+#include "extmod/vfs.h"
+#include "shared-bindings/_bleio/Characteristic.h"
+#include "shared-bindings/_bleio/PacketBuffer.h"
+#include "shared-bindings/_bleio/Service.h"
+#include "shared-bindings/_bleio/UUID.h"
+#include "supervisor/fatfs.h"
+#include "supervisor/filesystem.h"
+#include "supervisor/shared/bluetooth/file_transfer.h"
+#include "supervisor/shared/reload.h"
+#include "supervisor/shared/workflow.h"
+
+// The unix port has no radio, so this module is how tests talk to the BLE file transfer
+// service: the test plays the central, writing packets into the service's PacketBuffer
+// and reading back what it notifies. Files go to FAT filesystems mounted by the test.
+
+MP_DEFINE_CONST_OBJ_TYPE(bleio_uuid_type, MP_QSTR_UUID, MP_TYPE_FLAG_NONE);
+MP_DEFINE_CONST_OBJ_TYPE(bleio_characteristic_type, MP_QSTR_Characteristic, MP_TYPE_FLAG_NONE);
+MP_DEFINE_CONST_OBJ_TYPE(bleio_packet_buffer_type, MP_QSTR_PacketBuffer, MP_TYPE_FLAG_NONE);
+
+void common_hal_bleio_uuid_construct(bleio_uuid_obj_t *self, mp_int_t uuid16, const uint8_t uuid128[16]) {
+    self->uuid16 = uuid16;
+}
+
+uint32_t _common_hal_bleio_service_construct(bleio_service_obj_t *self, bleio_uuid_obj_t *uuid, bool is_secondary, mp_obj_list_t *characteristic_list) {
+    self->uuid = uuid;
+    self->characteristic_list = characteristic_list;
+    return 0;
+}
+
+void common_hal_bleio_service_deinit(bleio_service_obj_t *self) {
+}
+
+void common_hal_bleio_characteristic_construct(bleio_characteristic_obj_t *self, bleio_service_obj_t *service, uint16_t handle, bleio_uuid_obj_t *uuid, bleio_characteristic_properties_t props, bleio_attribute_security_mode_t read_perm, bleio_attribute_security_mode_t write_perm, mp_int_t max_length, bool fixed_length, mp_buffer_info_t *initial_value_bufinfo, const char *user_description) {
+    self->service = service;
+    self->uuid = uuid;
+}
+
+void common_hal_bleio_characteristic_deinit(bleio_characteristic_obj_t *self) {
+}
+
+static uint32_t version;
+
+void common_hal_bleio_characteristic_set_value(bleio_characteristic_obj_t *self, mp_buffer_info_t *bufinfo) {
+    if (bufinfo->len == sizeof(version)) {
+        memcpy(&version, bufinfo->buf, sizeof(version));
+    }
+}
+
+static bleio_packet_buffer_obj_t *packet_buffer;
+static uint16_t packet_length = 20;
+// Everything the service has notified since the last read().
+static uint8_t notified[4096];
+static size_t notified_len;
+
+void _common_hal_bleio_packet_buffer_construct(
+    bleio_packet_buffer_obj_t *self, bleio_characteristic_obj_t *characteristic,
+    uint32_t *incoming_buffer, size_t incoming_buffer_size,
+    uint32_t *outgoing_buffer1, uint32_t *outgoing_buffer2, size_t outgoing_buffer_size,
+    ble_event_handler_t *static_handler_entry) {
+    self->characteristic = characteristic;
+    ringbuf_init(&self->ringbuf, (uint8_t *)incoming_buffer, incoming_buffer_size);
+    self->max_packet_size = packet_length;
+    packet_buffer = self;
+}
+
+void common_hal_bleio_packet_buffer_deinit(bleio_packet_buffer_obj_t *self) {
+    packet_buffer = NULL;
+}
+
+mp_int_t common_hal_bleio_packet_buffer_readinto(bleio_packet_buffer_obj_t *self, uint8_t *data, size_t len) {
+    if (ringbuf_num_filled(&self->ringbuf) < 2) {
+        return 0;
+    }
+    uint16_t length;
+    ringbuf_get_n(&self->ringbuf, (uint8_t *)&length, sizeof(uint16_t));
+    if (length > len) {
+        // Discard the packet if it's too large, like the radio ports do.
+        for (size_t i = 0; i < length; i++) {
+            (void)ringbuf_get(&self->ringbuf);
+        }
+        return len - length;
+    }
+    ringbuf_get_n(&self->ringbuf, data, length);
+    return length;
+}
+
+mp_int_t common_hal_bleio_packet_buffer_write(bleio_packet_buffer_obj_t *self, const uint8_t *data, size_t len, uint8_t *header, size_t header_len) {
+    len = MIN(len, sizeof(notified) - notified_len);
+    memcpy(notified + notified_len, data, len);
+    notified_len += len;
+    return len;
+}
+
+mp_int_t common_hal_bleio_packet_buffer_get_incoming_packet_length(bleio_packet_buffer_obj_t *self) {
+    return self->max_packet_size;
+}
+
+mp_int_t common_hal_bleio_packet_buffer_get_outgoing_packet_length(bleio_packet_buffer_obj_t *self) {
+    return self->max_packet_size;
+}
+
+void common_hal_bleio_packet_buffer_flush(bleio_packet_buffer_obj_t *self) {
+}
+
+// The supervisor's filesystem.c is specific to CIRCUITPY. Here any FAT mount will do.
+fs_user_mount_t *filesystem_for_path(const char *path_in, const char **path_under_mount) {
+    mp_vfs_mount_t *vfs = mp_vfs_lookup_path(path_in, path_under_mount);
+    if (vfs == MP_VFS_NONE || vfs == MP_VFS_ROOT) {
+        return NULL;
+    }
+    return MP_OBJ_TO_PTR(vfs->obj);
+}
+
+bool filesystem_native_fatfs(fs_user_mount_t *fs_mount) {
+    return fs_mount->base.type == &mp_fat_vfs_type;
+}
+
+bool filesystem_lock(fs_user_mount_t *fs_mount) {
+    if (fs_mount->lock_count == 0) {
+        if ((fs_mount->blockdev.flags & MP_BLOCKDEV_FLAG_LOCKED) != 0) {
+            return false;
+        }
+        fs_mount->blockdev.flags |= MP_BLOCKDEV_FLAG_LOCKED;
+    }
+    fs_mount->lock_count += 1;
+    return true;
+}
+
+void filesystem_unlock(fs_user_mount_t *fs_mount) {
+    fs_mount->lock_count -= 1;
+    if (fs_mount->lock_count == 0) {
+        fs_mount->blockdev.flags &= ~MP_BLOCKDEV_FLAG_LOCKED;
+    }
+}
+
+// File times come from the host clock.
+void override_fattime(DWORD time) {
+}
+
+static size_t reloads;
+
+void autoreload_suspend(uint32_t suspend_reason_mask) {
+}
+
+void autoreload_resume(uint32_t suspend_reason_mask) {
+}
+
+void autoreload_trigger(void) {
+    reloads++;
+}
+
+// Only reads and writes are looped back.
+FRESULT supervisor_workflow_move(const char *old_path, const char *new_path) {
+    return FR_NO_PATH;
+}
+
+FRESULT supervisor_workflow_mkdir(DWORD fattime, const char *full_path) {
+    return FR_NO_PATH;
+}
+
+FRESULT supervisor_workflow_delete_recursive(const char *full_path) {
+    return FR_NO_PATH;
+}
+
+// start(packet_length) -> int
+//
+// Starts the service with packets of packet_length bytes each way and returns its version.
+static mp_obj_t ble_file_transfer_start(mp_obj_t packet_length_in) {
+    packet_length = mp_arg_validate_int_range(mp_obj_get_int(packet_length_in), 20, BLEIO_PACKET_BUFFER_MAX_PACKET_SIZE, MP_QSTR_packet_length);
+    notified_len = 0;
+    supervisor_start_bluetooth_file_transfer();
+    return MP_OBJ_NEW_SMALL_INT(version);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ble_file_transfer_start_obj, ble_file_transfer_start);
+
+// write(packet) -> None
+//
+// Delivers one packet from the central. As on the radio ports, the oldest packets are
+// dropped when the buffer is full. Nothing runs until background() is called.
+static mp_obj_t ble_file_transfer_write(mp_obj_t packet_in) {
+    if (packet_buffer == NULL) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Not connected"));
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(packet_in, &bufinfo, MP_BUFFER_READ);
+    ringbuf_t *ringbuf = &packet_buffer->ringbuf;
+    uint16_t len = mp_arg_validate_length_max(bufinfo.len, packet_buffer->max_packet_size, MP_QSTR_packet);
+    while (ringbuf_num_empty(ringbuf) < len + sizeof(uint16_t)) {
+        uint16_t dropped;
+        ringbuf_get_n(ringbuf, (uint8_t *)&dropped, sizeof(uint16_t));
+        while (dropped--) {
+            (void)ringbuf_get(ringbuf);
+        }
+    }
+    ringbuf_put_n(ringbuf, (uint8_t *)&len, sizeof(uint16_t));
+    ringbuf_put_n(ringbuf, bufinfo.buf, len);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ble_file_transfer_write_obj, ble_file_transfer_write);
+
+// background() -> None
+static mp_obj_t ble_file_transfer_background(void) {
+    supervisor_bluetooth_file_transfer_background();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_file_transfer_background_obj, ble_file_transfer_background);
+
+// read() -> bytes
+//
+// Returns everything the service has notified since the last call.
+static mp_obj_t ble_file_transfer_read(void) {
+    mp_obj_t result = mp_obj_new_bytes(notified, notified_len);
+    notified_len = 0;
+    return result;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_file_transfer_read_obj, ble_file_transfer_read);
+
+// disconnect() -> None
+static mp_obj_t ble_file_transfer_disconnect(void) {
+    supervisor_bluetooth_file_transfer_disconnected();
+    if (packet_buffer != NULL) {
+        ringbuf_clear(&packet_buffer->ringbuf);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_file_transfer_disconnect_obj, ble_file_transfer_disconnect);
+
+// reloads() -> int
+//
+// How many times the service has asked for an autoreload.
+static mp_obj_t ble_file_transfer_reloads(void) {
+    return mp_obj_new_int_from_uint(reloads);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_file_transfer_reloads_obj, ble_file_transfer_reloads);
+
+static const mp_rom_map_elem_t ble_file_transfer_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ble_file_transfer) },
+    { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&ble_file_transfer_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&ble_file_transfer_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_background), MP_ROM_PTR(&ble_file_transfer_background_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&ble_file_transfer_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_disconnect), MP_ROM_PTR(&ble_file_transfer_disconnect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reloads), MP_ROM_PTR(&ble_file_transfer_reloads_obj) },
+};
+static MP_DEFINE_CONST_DICT(ble_file_transfer_module_globals, ble_file_transfer_module_globals_table);
+
+const mp_obj_module_t ble_file_transfer_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&ble_file_transfer_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_ble_file_transfer, ble_file_transfer_module);
+
+#endif
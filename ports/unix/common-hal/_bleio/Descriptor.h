@@ -0,0 +1,14 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "common-hal/_bleio/UUID.h"
+
+typedef struct _bleio_descriptor_obj {
+    mp_obj_base_t base;
+} bleio_descriptor_obj_t;
@@ -0,0 +1,24 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/ringbuf.h"
+#include "shared-bindings/_bleio/Characteristic.h"
+
+// The unix port has no radio. Its PacketBuffer is a loopback: ble_file_transfer.c queues
+// the packets a central would write and collects the notifications sent back.
+typedef struct {
+    mp_obj_base_t base;
+    bleio_characteristic_obj_t *characteristic;
+    // Packets from the central, each preceded by its uint16_t length.
+    ringbuf_t ringbuf;
+    uint16_t max_packet_size;
+} bleio_packet_buffer_obj_t;
+
+typedef struct {
+    bool unused;
+} ble_event_handler_t;
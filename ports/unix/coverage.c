@@ -144,6 +144,108 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &rawfile_locals_dict2
     );
 
+// CIRCUITPY-CHANGE: pollable stream for testing mp_stream_poll_notify()
+typedef struct _mp_obj_stest_poll_t {
+    mp_obj_base_t base;
+    mp_uint_t ready;
+    mp_uint_t notifies;
+    size_t polls;
+    mp_uint_t pending_ready;
+    size_t pending_polls;
+    size_t pending_notify;
+} mp_obj_stest_poll_t;
+
+static void stest_poll_make_ready(mp_obj_stest_poll_t *o, mp_uint_t flags, size_t notify) {
+    o->ready = flags;
+    while (notify-- > 0) {
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(o));
+    }
+}
+
+// stest_poll(notifies): a stream that answers notifies for MP_STREAM_POLL_NOTIFIES
+static mp_obj_t stest_poll_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    mp_obj_stest_poll_t *o = mp_obj_malloc(mp_obj_stest_poll_t, type);
+    o->ready = 0;
+    o->notifies = mp_obj_get_int(args[0]);
+    o->polls = 0;
+    o->pending_polls = 0;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+// set_ready(flags, notify, after): flags become ready once the stream has been
+// polled `after` more times (immediately if 0), and are then signalled notify
+// times
+static mp_obj_t stest_poll_set_ready(size_t n_args, const mp_obj_t *args) {
+    mp_obj_stest_poll_t *o = MP_OBJ_TO_PTR(args[0]);
+    o->pending_ready = mp_obj_get_int(args[1]);
+    o->pending_notify = mp_obj_get_int(args[2]);
+    o->pending_polls = mp_obj_get_int(args[3]);
+    if (o->pending_polls == 0) {
+        stest_poll_make_ready(o, o->pending_ready, o->pending_notify);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(stest_poll_set_ready_obj, 4, 4, stest_poll_set_ready);
+
+// Returns the number of MP_STREAM_POLL requests since the last call.
+static mp_obj_t stest_poll_polls(mp_obj_t o_in) {
+    mp_obj_stest_poll_t *o = MP_OBJ_TO_PTR(o_in);
+    size_t polls = o->polls;
+    o->polls = 0;
+    return MP_OBJ_NEW_SMALL_INT(polls);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(stest_poll_polls_obj, stest_poll_polls);
+
+// set_notifies(flags): the flags answered for MP_STREAM_POLL_NOTIFIES
+static mp_obj_t stest_poll_set_notifies(mp_obj_t o_in, mp_obj_t flags_in) {
+    mp_obj_stest_poll_t *o = MP_OBJ_TO_PTR(o_in);
+    o->notifies = mp_obj_get_int(flags_in);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(stest_poll_set_notifies_obj, stest_poll_set_notifies);
+
+static mp_uint_t stest_poll_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_stest_poll_t *o = MP_OBJ_TO_PTR(o_in);
+    switch (request) {
+        case MP_STREAM_POLL: {
+            // ERR and HUP are reported whether asked for or not.
+            mp_uint_t ret = o->ready & (arg | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP);
+            o->polls++;
+            if (o->pending_polls > 0 && --o->pending_polls == 0) {
+                stest_poll_make_ready(o, o->pending_ready, o->pending_notify);
+            }
+            return ret;
+        }
+        case MP_STREAM_POLL_NOTIFIES:
+            return o->notifies;
+        default:
+            *errcode = MP_EINVAL;
+            return MP_STREAM_ERROR;
+    }
+}
+
+static const mp_rom_map_elem_t stest_poll_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_set_ready), MP_ROM_PTR(&stest_poll_set_ready_obj) },
+    { MP_ROM_QSTR(MP_QSTR_polls), MP_ROM_PTR(&stest_poll_polls_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_notifies), MP_ROM_PTR(&stest_poll_set_notifies_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(stest_poll_locals_dict, stest_poll_locals_dict_table);
+
+static const mp_stream_p_t stest_poll_stream_p = {
+    .ioctl = stest_poll_ioctl,
+};
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_stest_poll,
+    MP_QSTR_stest_poll,
+    MP_TYPE_FLAG_NONE,
+    make_new, stest_poll_make_new,
+    protocol, &stest_poll_stream_p,
+    locals_dict, &stest_poll_locals_dict
+    );
+
 // str/bytes objects without a valid hash
 static const mp_obj_str_t str_no_hash_obj = {{&mp_type_str}, 0, 10, (const byte *)"0123456789"};
 static const mp_obj_str_t bytes_no_hash_obj = {{&mp_type_bytes}, 0, 10, (const byte *)"0123456789"};
@@ -681,6 +783,65 @@ static mp_obj_t extra_coverage(void) {
         ringbuf_clear(&ringbuf);
         ringbuf_put(&ringbuf, 0xaa);
         mp_printf(&mp_plat_print, "%d\n", ringbuf_get16(&ringbuf));
+
+        // Multi-byte put/get with wrap around.
+        ringbuf_clear(&ringbuf);
+        for (int i = 0; i < RINGBUF_SIZE - 5; ++i) {
+            ringbuf_put(&ringbuf, i);
+            ringbuf_get(&ringbuf);
+        }
+        uint8_t out[12];
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_put_n(&ringbuf, (const uint8_t *)"0123456789", 10));
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_get_n(&ringbuf, out, sizeof(out)));
+        mp_printf(&mp_plat_print, "%.10s\n", out);
+    }
+
+    // CIRCUITPY-CHANGE: single-producer single-consumer ringbuf
+    {
+        mp_printf(&mp_plat_print, "# ringbuf_spsc\n");
+
+        static const uint8_t data[] = "abcdefghijkl";
+        // A power-of-two size (wraps with a mask) and one that isn't.
+        static const size_t sizes[] = {8, 10};
+        for (size_t i = 0; i < MP_ARRAY_SIZE(sizes); i++) {
+            byte buf[10];
+            uint8_t out[16];
+            ringbuf_spsc_t ringbuf;
+            ringbuf_spsc_init(&ringbuf, buf, sizes[i]);
+
+            // Fill beyond capacity, then drain.
+            size_t put = ringbuf_spsc_put_n(&ringbuf, data, 12);
+            mp_printf(&mp_plat_print, "%d %d %d\n", (int)put, (int)ringbuf_spsc_num_filled(&ringbuf), (int)ringbuf_spsc_num_empty(&ringbuf));
+            size_t got = ringbuf_spsc_get_n(&ringbuf, out, sizeof(out));
+            mp_printf(&mp_plat_print, "%.*s %d\n", (int)got, out, (int)ringbuf_spsc_num_filled(&ringbuf));
+
+            // Put and get across the end of the buffer, many times over.
+            size_t ok = 0;
+            for (size_t j = 0; j < 25; j++) {
+                put = ringbuf_spsc_put_n(&ringbuf, data, 5);
+                got = ringbuf_spsc_get_n(&ringbuf, out, 5);
+                ok += put == 5 && got == 5 && memcmp(out, data, 5) == 0;
+            }
+            mp_printf(&mp_plat_print, "%d %d\n", (int)ok, (int)ringbuf_spsc_num_filled(&ringbuf));
+
+            // Spans stop at the end of the buffer.
+            ringbuf_spsc_clear(&ringbuf);
+            size_t len;
+            uint8_t *wspan = ringbuf_spsc_write_span(&ringbuf, &len);
+            mp_printf(&mp_plat_print, "%d %d\n", (int)(wspan - buf), (int)len);
+            memcpy(wspan, data, 2);
+            ringbuf_spsc_write_commit(&ringbuf, 2);
+            const uint8_t *rspan = ringbuf_spsc_read_span(&ringbuf, &len);
+            mp_printf(&mp_plat_print, "%d %d %.*s\n", (int)(rspan - buf), (int)len, (int)len, rspan);
+            ringbuf_spsc_read_commit(&ringbuf, len);
+            ringbuf_spsc_put_n(&ringbuf, data, sizes[i]);
+            rspan = ringbuf_spsc_read_span(&ringbuf, &len);
+            mp_printf(&mp_plat_print, "%d %d %.*s\n", (int)(rspan - buf), (int)len, (int)len, rspan);
+            wspan = ringbuf_spsc_write_span(&ringbuf, &len);
+            mp_printf(&mp_plat_print, "%d\n", (int)len);
+            ringbuf_spsc_clear(&ringbuf);
+            mp_printf(&mp_plat_print, "%d %d\n", (int)ringbuf_spsc_num_filled(&ringbuf), (int)ringbuf_spsc_num_empty(&ringbuf));
+        }
     }
 
     // pairheap
@@ -737,9 +898,14 @@ static mp_obj_t extra_coverage(void) {
     s->pos = 0;
     s->error_code = 0;
     mp_obj_streamtest_t *s2 = mp_obj_malloc(mp_obj_streamtest_t, &mp_type_stest_textio2);
+    // CIRCUITPY-CHANGE: one pollable stream that signals readiness, one that doesn't
+    mp_obj_t s3_notifies = MP_OBJ_NEW_SMALL_INT(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP);
+    mp_obj_t s3 = stest_poll_make_new(&mp_type_stest_poll, 1, 0, &s3_notifies);
+    mp_obj_t s4_notifies = MP_OBJ_NEW_SMALL_INT(0);
+    mp_obj_t s4 = stest_poll_make_new(&mp_type_stest_poll, 1, 0, &s4_notifies);
 
     // return a tuple of data for testing on the Python side
-    mp_obj_t items[] = {(mp_obj_t)&str_no_hash_obj, (mp_obj_t)&bytes_no_hash_obj, MP_OBJ_FROM_PTR(s), MP_OBJ_FROM_PTR(s2)};
+    mp_obj_t items[] = {(mp_obj_t)&str_no_hash_obj, (mp_obj_t)&bytes_no_hash_obj, MP_OBJ_FROM_PTR(s), MP_OBJ_FROM_PTR(s2), s3, s4};
     return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
 }
 MP_DEFINE_CONST_FUN_OBJ_0(extra_coverage_obj, extra_coverage);
@@ -0,0 +1,216 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "py/mperrno.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#if defined(MICROPY_UNIX_COVERAGE) && SIM_FLASH_FILESYSTEM
+
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/flash.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/shared/external_flash/sim_flash.h"
+#include "supervisor/shared/tick.h"
+#include "supervisor/spi_flash_api.h"
+
+// The unix port has no flash chip, so this module is how tests drive the
+// external flash cache: it runs external_flash.c over the ram backed chip in
+// sim_flash.c and lets tests watch its heap use, ticks and clock.
+
+// Each allocation is prefixed with its size so that live bytes can be tracked.
+typedef union {
+    size_t size;
+    uint64_t align;
+} heap_header_t;
+
+static size_t heap_allocs;
+static size_t heap_live_bytes;
+
+void *port_malloc(size_t size, bool dma_capable) {
+    heap_header_t *header = malloc(sizeof(heap_header_t) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    heap_allocs++;
+    heap_live_bytes += size;
+    return header + 1;
+}
+
+void port_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    heap_header_t *header = (heap_header_t *)ptr - 1;
+    heap_live_bytes -= header->size;
+    free(header);
+}
+
+void common_hal_mcu_delay_us(uint32_t delay) {
+}
+
+static uint32_t ticks_ms;
+static uint32_t ticks_held;
+
+uint32_t supervisor_ticks_ms32(void) {
+    return ticks_ms;
+}
+
+void supervisor_enable_tick(void) {
+    ticks_held++;
+}
+
+void supervisor_disable_tick(void) {
+    if (ticks_held > 0) {
+        ticks_held--;
+    }
+}
+
+static void check_buffer(mp_obj_t buf_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    mp_get_buffer_raise(buf_in, bufinfo, flags);
+    if (bufinfo->len == 0 || bufinfo->len % FILESYSTEM_BLOCK_SIZE != 0) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Buffer must be a multiple of %d bytes"), FILESYSTEM_BLOCK_SIZE);
+    }
+}
+
+// init() -> int
+//
+// Finds the simulated chip and returns how many blocks the filesystem gets.
+static mp_obj_t external_flash_sim_init(void) {
+    supervisor_flash_init();
+    return mp_obj_new_int_from_uint(supervisor_flash_get_block_count());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_init_obj, external_flash_sim_init);
+
+// readblocks(block, buf) -> None
+static mp_obj_t external_flash_sim_readblocks(mp_obj_t block_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    check_buffer(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    if (supervisor_flash_read_blocks(bufinfo.buf, mp_obj_get_int(block_in), bufinfo.len / FILESYSTEM_BLOCK_SIZE) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(external_flash_sim_readblocks_obj, external_flash_sim_readblocks);
+
+// writeblocks(block, buf) -> None
+static mp_obj_t external_flash_sim_writeblocks(mp_obj_t block_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    check_buffer(buf_in, &bufinfo, MP_BUFFER_READ);
+    if (supervisor_flash_write_blocks(bufinfo.buf, mp_obj_get_int(block_in), bufinfo.len / FILESYSTEM_BLOCK_SIZE) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(external_flash_sim_writeblocks_obj, external_flash_sim_writeblocks);
+
+// flush() -> None
+//
+// A periodic flush, as the supervisor does every second while ticks are on.
+static mp_obj_t external_flash_sim_flush(void) {
+    supervisor_external_flash_flush();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_flush_obj, external_flash_sim_flush);
+
+// release() -> None
+//
+// Flushes and gives all of the cache's ram back, as before the VM starts.
+static mp_obj_t external_flash_sim_release(void) {
+    supervisor_flash_release_cache();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_release_obj, external_flash_sim_release);
+
+// raw(block, buf) -> None
+//
+// Reads what the chip itself holds, bypassing the cache, without counting it
+// in stats().
+static mp_obj_t external_flash_sim_raw(mp_obj_t block_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    check_buffer(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    sim_flash_stats_t stats = sim_flash_stats;
+    bool ok = spi_flash_read_data(mp_obj_get_int(block_in) * FILESYSTEM_BLOCK_SIZE, bufinfo.buf, bufinfo.len);
+    sim_flash_stats = stats;
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(external_flash_sim_raw_obj, external_flash_sim_raw);
+
+// stats() -> (sector_erases, page_programs, reads, bytes_read)
+//
+// Chip operations since the last call.
+static mp_obj_t external_flash_sim_stats(void) {
+    mp_obj_t result[] = {
+        mp_obj_new_int_from_uint(sim_flash_stats.sector_erases),
+        mp_obj_new_int_from_uint(sim_flash_stats.page_programs),
+        mp_obj_new_int_from_uint(sim_flash_stats.reads),
+        mp_obj_new_int_from_uint(sim_flash_stats.bytes_read),
+    };
+    sim_flash_reset_stats();
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(result), result);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_stats_obj, external_flash_sim_stats);
+
+// ram() -> (allocations, live_bytes)
+//
+// How many port_malloc calls the cache has made in total, and how many bytes
+// it holds now.
+static mp_obj_t external_flash_sim_ram(void) {
+    mp_obj_t result[] = {
+        mp_obj_new_int_from_uint(heap_allocs),
+        mp_obj_new_int_from_uint(heap_live_bytes),
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(result), result);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_ram_obj, external_flash_sim_ram);
+
+// advance(ms) -> None
+//
+// Moves the supervisor clock forward.
+static mp_obj_t external_flash_sim_advance(mp_obj_t ms_in) {
+    ticks_ms += mp_obj_get_int(ms_in);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(external_flash_sim_advance_obj, external_flash_sim_advance);
+
+// ticks_held() -> int
+//
+// How many supervisor_enable_tick() calls haven't been undone.
+static mp_obj_t external_flash_sim_ticks_held(void) {
+    return mp_obj_new_int_from_uint(ticks_held);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(external_flash_sim_ticks_held_obj, external_flash_sim_ticks_held);
+
+static const mp_rom_map_elem_t external_flash_sim_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_external_flash_sim) },
+    { MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&external_flash_sim_init_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&external_flash_sim_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&external_flash_sim_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&external_flash_sim_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release), MP_ROM_PTR(&external_flash_sim_release_obj) },
+    { MP_ROM_QSTR(MP_QSTR_raw), MP_ROM_PTR(&external_flash_sim_raw_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&external_flash_sim_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ram), MP_ROM_PTR(&external_flash_sim_ram_obj) },
+    { MP_ROM_QSTR(MP_QSTR_advance), MP_ROM_PTR(&external_flash_sim_advance_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ticks_held), MP_ROM_PTR(&external_flash_sim_ticks_held_obj) },
+};
+static MP_DEFINE_CONST_DICT(external_flash_sim_module_globals, external_flash_sim_module_globals_table);
+
+const mp_obj_module_t external_flash_sim_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&external_flash_sim_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_external_flash_sim, external_flash_sim_module);
+
+#endif
@@ -0,0 +1,61 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/mphal.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#if defined(MICROPY_UNIX_COVERAGE) && CIRCUITPY_KEYPAD
+
+#include "shared-bindings/keypad/Event.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-bindings/supervisor/__init__.h"
+#include "shared-module/keypad/EventQueue.h"
+
+// The unix port has no pins to scan, so this module is how tests fill a
+// keypad.EventQueue: record() queues an event the way a scanner does.
+
+// Used by keypad.Event() when no timestamp is given.
+mp_obj_t supervisor_ticks_ms(void) {
+    return mp_obj_new_int((mp_hal_ticks_ms() + 0x1fff0000) % (1 << 29));
+}
+
+// EventQueue(max_events) -> keypad.EventQueue
+static mp_obj_t keypad_events_eventqueue(mp_obj_t max_events_in) {
+    mp_int_t max_events = mp_arg_validate_int_range(mp_obj_get_int(max_events_in), 1, 1024, MP_QSTR_max_events);
+    keypad_eventqueue_obj_t *events = mp_obj_malloc(keypad_eventqueue_obj_t, &keypad_eventqueue_type);
+    common_hal_keypad_eventqueue_construct(events, max_events);
+    return MP_OBJ_FROM_PTR(events);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(keypad_events_eventqueue_obj, keypad_events_eventqueue);
+
+// record(queue, key_number, pressed, timestamp) -> bool
+//
+// Returns False, and sets queue.overflowed, if the queue is full.
+static mp_obj_t keypad_events_record(size_t n_args, const mp_obj_t *args) {
+    keypad_eventqueue_obj_t *events = MP_OBJ_TO_PTR(mp_arg_validate_type(args[0], &keypad_eventqueue_type, MP_QSTR_queue));
+    mp_uint_t key_number = mp_obj_get_int(args[1]);
+    bool pressed = mp_obj_is_true(args[2]);
+    return mp_obj_new_bool(keypad_eventqueue_record(events, key_number, pressed, args[3]));
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(keypad_events_record_obj, 4, 4, keypad_events_record);
+
+static const mp_rom_map_elem_t keypad_events_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_keypad_events) },
+    { MP_ROM_QSTR(MP_QSTR_Event), MP_ROM_PTR(&keypad_event_type) },
+    { MP_ROM_QSTR(MP_QSTR_EventQueue), MP_ROM_PTR(&keypad_events_eventqueue_obj) },
+    { MP_ROM_QSTR(MP_QSTR_record), MP_ROM_PTR(&keypad_events_record_obj) },
+};
+static MP_DEFINE_CONST_DICT(keypad_events_module_globals, keypad_events_module_globals_table);
+
+const mp_obj_module_t keypad_events_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&keypad_events_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_keypad_events, keypad_events_module);
+
+#endif
@@ -41,6 +41,13 @@
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
 #define MICROPY_WARNINGS_CATEGORY      (1)
+// CIRCUITPY-CHANGE: build the in-place .mpy loader; no unix filesystem offers
+// MP_STREAM_GET_BUFFER_PTR, so .mpy files are still loaded by copying
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (1)
+// CIRCUITPY-CHANGE: resolve imports from cached directory listings
+#define MICROPY_VFS_IMPORT_STAT_CACHE (1)
+// CIRCUITPY-CHANGE: gifio.OnDiskGif reads files on a VfsFat mount
+#define mp_type_fileio mp_type_vfs_fat_fileio
 
 // CIRCUITPY-CHANGE: Disable things never used in circuitpython
 #define MICROPY_PY_CRYPTOLIB          (0)
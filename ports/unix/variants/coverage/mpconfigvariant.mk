@@ -28,6 +28,8 @@ SRC_BITMAP := \
 	shared/runtime/context_manager_helpers.c \
 	displayio_min.c \
 	shared-bindings/__future__/__init__.c \
+	shared-bindings/adafruit_pixelbuf/__init__.c \
+	shared-bindings/adafruit_pixelbuf/PixelBuf.c \
 	shared-bindings/aesio/aes.c \
 	shared-bindings/aesio/__init__.c \
 	shared-bindings/audiocore/__init__.c \
@@ -50,10 +52,17 @@ SRC_BITMAP := \
 	shared-bindings/displayio/Bitmap.c \
 	shared-bindings/displayio/ColorConverter.c \
 	shared-bindings/displayio/Palette.c \
+	shared-bindings/gifio/__init__.c \
+	shared-bindings/gifio/GifWriter.c \
+	shared-bindings/gifio/OnDiskGif.c \
 	shared-bindings/floppyio/__init__.c \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
+	shared-bindings/keypad/Event.c \
+	shared-bindings/keypad/EventQueue.c \
 	shared-bindings/locale/__init__.c \
+	shared-bindings/msgpack/__init__.c \
+	shared-bindings/msgpack/ExtType.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
 	shared-bindings/synthio/__init__.c \
@@ -72,6 +81,7 @@ SRC_BITMAP := \
 	shared-bindings/vectorio/Rectangle.c \
 	shared-bindings/vectorio/VectorShape.c \
 	shared-bindings/zlib/__init__.c \
+	shared-module/adafruit_pixelbuf/PixelBuf.c \
 	shared-module/aesio/aes.c \
 	shared-module/aesio/__init__.c \
 	shared-module/audiocore/__init__.c \
@@ -94,8 +104,13 @@ SRC_BITMAP := \
 	shared-module/displayio/ColorConverter.c \
 	shared-module/displayio/Palette.c \
 	shared-module/floppyio/__init__.c \
+	shared-module/gifio/GifWriter.c \
+	shared-module/gifio/OnDiskGif.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/keypad/Event.c \
+	shared-module/keypad/EventQueue.c \
+	shared-module/msgpack/__init__.c \
 	shared-module/os/getenv.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
@@ -117,6 +132,10 @@ SRC_BITMAP := \
 	shared-module/zlib/__init__.c \
 
 SRC_C += $(SRC_BITMAP)
+$(BUILD)/shared-bindings/msgpack/%.o: CFLAGS += -Wno-missing-field-initializers
+
+SRC_C += lib/AnimatedGIF/gif.c
+$(BUILD)/lib/AnimatedGIF/gif.o: CFLAGS += -DCIRCUITPY -Wno-missing-prototypes -Wno-shadow
 
 SRC_C += $(addprefix lib/mp3/src/, \
         bitstream.c \
@@ -148,23 +167,41 @@ CFLAGS += \
 	-DCIRCUITPY_AUDIOMP3=1 \
 	-DCIRCUITPY_AUDIOCORE_DEBUG=1 \
 	-DCIRCUITPY_BITMAPTOOLS=1 \
+	-DCIRCUITPY_BLE_FILE_SERVICE=1 \
 	-DCIRCUITPY_CODEOP=1 \
 	-DCIRCUITPY_DISPLAYIO_UNIX=1 \
 	-DCIRCUITPY_FLOPPYIO=1 \
 	-DCIRCUITPY_FUTURE=1 \
 	-DCIRCUITPY_GIFIO=1 \
 	-DCIRCUITPY_JPEGIO=1 \
+	-DCIRCUITPY_KEYPAD=1 \
 	-DCIRCUITPY_LOCALE=1 \
+	-DCIRCUITPY_MSGPACK=1 \
 	-DCIRCUITPY_OS_GETENV=1 \
+	-DCIRCUITPY_PIXELBUF=1 \
+	-DCIRCUITPY_PIXELBUF_EFFECTS=1 \
+	-DCIRCUITPY_PROCESSOR_COUNT=1 \
 	-DCIRCUITPY_RAINBOWIO=1 \
 	-DCIRCUITPY_STRUCT=1 \
 	-DCIRCUITPY_SYNTHIO=1 \
 	-DCIRCUITPY_SYNTHIO_MAX_CHANNELS=14 \
 	-DCIRCUITPY_TRACEBACK=1 \
 	-DCIRCUITPY_VECTORIO=1 \
-	-DCIRCUITPY_ZLIB=1
+	-DCIRCUITPY_ZLIB=1 \
+	-DFILESYSTEM_BLOCK_SIZE=512 \
+	-DSIM_FLASH_FILESYSTEM=1 \
+	-DSPI_FLASH_READ_AHEAD_BLOCKS=4
 
 # CIRCUITPY-CHANGE: test native base classes.
 SRC_C += coverage.c native_base_class.c
+# CIRCUITPY-CHANGE: draw vectorio shapes without a display.
+SRC_C += vectorio_fill.c
+# CIRCUITPY-CHANGE: fill keypad event queues without pins to scan.
+SRC_C += keypad_events.c
+# CIRCUITPY-CHANGE: run the BLE file transfer service over a loopback PacketBuffer.
+SRC_C += ble_file_transfer.c supervisor/shared/bluetooth/file_transfer.c
+# CIRCUITPY-CHANGE: run the external flash cache over a simulated chip in ram.
+SRC_C += external_flash_sim.c supervisor/shared/external_flash/external_flash.c supervisor/shared/external_flash/sim_flash.c
+$(BUILD)/supervisor/shared/external_flash/external_flash.o: CFLAGS += -Wno-type-limits
 SRC_CXX += coveragecpp.cpp
 CIRCUITPY_MESSAGE_COMPRESSION_LEVEL = 1
@@ -0,0 +1,130 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/proto.h"
+#include "py/runtime.h"
+
+#if defined(MICROPY_UNIX_COVERAGE) && CIRCUITPY_VECTORIO
+
+#include "shared-bindings/vectorio/__init__.h"
+#include "shared-module/vectorio/VectorShape.h"
+
+// The unix port has no displays, so this module is how tests draw vectorio
+// shapes: it calls the draw protocol's fill_area the way a display refresh does.
+
+// fill_area(shape, area, transform, *, spans=True, premask=0) -> (rows, pixels, full_coverage)
+//
+// area is (x1, y1, x2, y2) in screen coordinates and transform is the group
+// transform (x, y, dx, dy, transpose_xy). If premask is nonzero, every
+// premask'th pixel of the area is masked beforehand, as if drawn by a layer
+// above. spans=False makes the shape use the per-pixel path. Each row is a
+// str with '#' for pixels the shape drew, '-' for premasked pixels and '.'
+// for the rest; pixels is the RGB565 buffer.
+static mp_obj_t vectorio_fill_fill_area(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_shape, ARG_area, ARG_transform, ARG_spans, ARG_premask };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_shape, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_area, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_transform, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_spans, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_premask, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t shape = args[ARG_shape].u_obj;
+    const vectorio_draw_protocol_t *draw_protocol = mp_proto_get_or_throw(MP_QSTR_protocol_draw, shape);
+    mp_obj_t draw_self = draw_protocol->draw_get_protocol_self(shape);
+    vectorio_vector_shape_t *vector_shape = MP_OBJ_TO_PTR(draw_self);
+
+    mp_obj_t *items;
+    mp_obj_get_array_fixed_n(args[ARG_area].u_obj, 4, &items);
+    displayio_area_t area = {
+        .x1 = mp_obj_get_int(items[0]),
+        .y1 = mp_obj_get_int(items[1]),
+        .x2 = mp_obj_get_int(items[2]),
+        .y2 = mp_obj_get_int(items[3]),
+    };
+    mp_obj_get_array_fixed_n(args[ARG_transform].u_obj, 5, &items);
+    displayio_buffer_transform_t transform = {
+        .x = mp_obj_get_int(items[0]),
+        .y = mp_obj_get_int(items[1]),
+        .dx = mp_obj_get_int(items[2]),
+        .dy = mp_obj_get_int(items[3]),
+        .scale = 1,
+        .transpose_xy = mp_obj_is_true(items[4]),
+    };
+
+    int width = displayio_area_width(&area);
+    int height = displayio_area_height(&area);
+    int count = width * height;
+    uint32_t *mask = m_new0(uint32_t, (count + 31) / 32);
+    uint32_t *premask = m_new0(uint32_t, (count + 31) / 32);
+    uint16_t *buffer = m_new0(uint16_t, count + 1);
+    mp_int_t premask_every = args[ARG_premask].u_int;
+    for (int i = 0; premask_every > 0 && i < count; i += premask_every) {
+        premask[i / 32] |= 1u << (i % 32);
+    }
+    memcpy(mask, premask, (count + 31) / 32 * sizeof(uint32_t));
+
+    _displayio_colorspace_t colorspace = {
+        .depth = 16,
+        .bytes_per_cell = 2,
+        .pixels_in_byte_share_row = true,
+    };
+
+    get_spans_function *get_spans = vector_shape->ishape.get_spans;
+    if (!args[ARG_spans].u_bool) {
+        vector_shape->ishape.get_spans = NULL;
+    }
+    draw_protocol->draw_protocol_impl->draw_update_transform(draw_self, &transform);
+    bool full_coverage = draw_protocol->draw_protocol_impl->draw_fill_area(draw_self, &colorspace, &area, mask, (uint32_t *)buffer);
+    draw_protocol->draw_protocol_impl->draw_update_transform(draw_self, NULL);
+    vector_shape->ishape.get_spans = get_spans;
+
+    mp_obj_t rows = mp_obj_new_list(0, NULL);
+    vstr_t row;
+    vstr_init(&row, width);
+    for (int y = 0; y < height; y++) {
+        vstr_reset(&row);
+        for (int x = 0; x < width; x++) {
+            int i = y * width + x;
+            uint32_t bit = 1u << (i % 32);
+            vstr_add_byte(&row, (premask[i / 32] & bit) ? '-' : (mask[i / 32] & bit) ? '#' : '.');
+        }
+        mp_obj_list_append(rows, mp_obj_new_str(row.buf, row.len));
+    }
+    vstr_clear(&row);
+
+    mp_obj_t result[] = {
+        rows,
+        mp_obj_new_bytes((const byte *)buffer, count * sizeof(uint16_t)),
+        mp_obj_new_bool(full_coverage),
+    };
+    m_del(uint32_t, mask, (count + 31) / 32);
+    m_del(uint32_t, premask, (count + 31) / 32);
+    m_del(uint16_t, buffer, count + 1);
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(result), result);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(vectorio_fill_fill_area_obj, 3, vectorio_fill_fill_area);
+
+static const mp_rom_map_elem_t vectorio_fill_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_vectorio_fill) },
+    { MP_ROM_QSTR(MP_QSTR_fill_area), MP_ROM_PTR(&vectorio_fill_fill_area_obj) },
+};
+static MP_DEFINE_CONST_DICT(vectorio_fill_module_globals, vectorio_fill_module_globals_table);
+
+const mp_obj_module_t vectorio_fill_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&vectorio_fill_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_vectorio_fill, vectorio_fill_module);
+
+#endif
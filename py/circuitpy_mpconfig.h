@@ -177,6 +177,7 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_VFS                 (1)
 #define MICROPY_VFS_FAT             (MICROPY_VFS)
 #define MICROPY_READER_VFS          (MICROPY_VFS)
+#define MICROPY_VFS_IMPORT_STAT_CACHE (MICROPY_VFS)
 
 // type definitions for the specific machine
 
@@ -234,6 +235,12 @@ typedef long mp_off_t;
 #define MICROPY_CPYTHON_EXCEPTION_CHAIN       (CIRCUITPY_FULL_BUILD)
 #endif
 
+// Hash index over qstrs interned at runtime (attribute and dict key names from
+// user code and libraries), so lookups don't scan every runtime qstr pool.
+#ifndef MICROPY_ALLOC_QSTR_INDEX_INIT
+#define MICROPY_ALLOC_QSTR_INDEX_INIT         (CIRCUITPY_FULL_BUILD ? 64 : 0)
+#endif
+
 #define MICROPY_PY_BUILTINS_POW3              (CIRCUITPY_BUILTINS_POW3)
 #define MICROPY_PY_FSTRINGS                   (1)
 #define MICROPY_MODULE_WEAK_LINKS             (0)
@@ -442,6 +442,10 @@ CFLAGS += -DCIRCUITPY_QRIO=$(CIRCUITPY_QRIO)
 CIRCUITPY_RAINBOWIO ?= 1
 CFLAGS += -DCIRCUITPY_RAINBOWIO=$(CIRCUITPY_RAINBOWIO)
 
+# Native rainbow/chase/blend effects on PixelBuf. They use rainbowio.colorwheel().
+CIRCUITPY_PIXELBUF_EFFECTS ?= $(call enable-if-all,$(CIRCUITPY_PIXELBUF) $(CIRCUITPY_RAINBOWIO) $(CIRCUITPY_FULL_BUILD))
+CFLAGS += -DCIRCUITPY_PIXELBUF_EFFECTS=$(CIRCUITPY_PIXELBUF_EFFECTS)
+
 CIRCUITPY_RANDOM ?= 1
 CFLAGS += -DCIRCUITPY_RANDOM=$(CIRCUITPY_RANDOM)
 
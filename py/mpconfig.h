@@ -220,6 +220,13 @@
 #define MICROPY_ALLOC_QSTR_CHUNK_INIT (128)
 #endif
 
+// CIRCUITPY-CHANGE
+// Initial number of slots (a power of 2) in the hash index over qstrs interned
+// at runtime, or 0 to search the runtime qstr pools sequentially
+#ifndef MICROPY_ALLOC_QSTR_INDEX_INIT
+#define MICROPY_ALLOC_QSTR_INDEX_INIT (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES ? 64 : 0)
+#endif
+
 // Initial amount for lexer indentation level
 #ifndef MICROPY_ALLOC_LEXER_INDENT_INIT
 #define MICROPY_ALLOC_LEXER_INDENT_INIT (10)
@@ -342,6 +349,15 @@
 #define MICROPY_PERSISTENT_CODE_LOAD (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether .mpy files on storage that can keep their data in memory for the
+// life of the VM (see MP_STREAM_GET_BUFFER_PTR) are loaded in place: bytecode,
+// qstr data and str/bytes constants are referenced where they are instead of
+// being copied to the heap
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (0)
+#endif
+
 // Whether to support saving of persistent code, i.e. for mpy-cross to
 // generate .mpy files. Enabling this enables additional metadata on raw code
 // objects which is also required for sys.settrace.
@@ -1051,6 +1067,13 @@ typedef double mp_float_t;
 #define MICROPY_VFS_LFS2 (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether import resolves paths from cached directory listings instead of
+// stat'ing every candidate path on the filesystem
+#ifndef MICROPY_VFS_IMPORT_STAT_CACHE
+#define MICROPY_VFS_IMPORT_STAT_CACHE (0)
+#endif
+
 /*****************************************************************************/
 /* Fine control over Python builtins, classes, modules, etc                  */
 
@@ -1719,6 +1742,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_RE_SUB (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Number of compiled patterns remembered for module-level re.match/search/sub
+#ifndef MICROPY_PY_RE_CACHE_SIZE
+#define MICROPY_PY_RE_CACHE_SIZE (4)
+#endif
+
 #ifndef MICROPY_PY_HEAPQ
 #define MICROPY_PY_HEAPQ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
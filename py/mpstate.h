@@ -160,6 +160,11 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    // CIRCUITPY-CHANGE: hash index over the runtime-interned qstr pools
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    qstr *qstr_index;
+    #endif
+
     #if MICROPY_TRACKED_ALLOC
     struct _m_tracked_node_t *m_tracked_head;
     #endif
@@ -218,6 +223,9 @@ typedef struct _mp_state_vm_t {
     char *qstr_last_chunk;
     size_t qstr_last_alloc;
     size_t qstr_last_used;
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    size_t qstr_index_alloc;
+    #endif
 
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make qstr interning thread-safe.
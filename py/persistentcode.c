@@ -174,6 +174,15 @@ static qstr load_qstr(mp_reader_t *reader) {
         return len >> 1;
     }
     len >>= 1;
+    // CIRCUITPY-CHANGE: intern qstr data in place, with its null terminator
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    const char *rom_str = (const char *)mp_reader_try_read_rom(reader, len + 1);
+    if (rom_str != NULL && rom_str[len] == '\0') {
+        return qstr_from_strn_static(rom_str, len);
+    } else if (rom_str != NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("incompatible .mpy file"));
+    }
+    #endif
     char *str = m_new(char, len);
     read_bytes(reader, (byte *)str, len);
     read_byte(reader); // read and discard null terminator
@@ -209,6 +218,26 @@ static mp_obj_t load_obj(mp_reader_t *reader) {
             }
             return MP_OBJ_FROM_PTR(tuple);
         }
+        // CIRCUITPY-CHANGE: reference str/bytes data in place
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+        if (obj_type == MP_PERSISTENT_OBJ_STR || obj_type == MP_PERSISTENT_OBJ_BYTES) {
+            const byte *data = mp_reader_try_read_rom(reader, len + 1);
+            if (data != NULL) {
+                if (obj_type == MP_PERSISTENT_OBJ_STR) {
+                    qstr q = qstr_find_strn((const char *)data, len);
+                    if (q != MP_QSTRnull) {
+                        return MP_OBJ_NEW_QSTR(q);
+                    }
+                }
+                mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t,
+                    obj_type == MP_PERSISTENT_OBJ_STR ? &mp_type_str : &mp_type_bytes);
+                o->hash = qstr_compute_hash(data, len);
+                o->len = len;
+                o->data = data;
+                return MP_OBJ_FROM_PTR(o);
+            }
+        }
+        #endif
         vstr_t vstr;
         vstr_init_len(&vstr, len);
         read_bytes(reader, (byte *)vstr.buf, len);
@@ -250,10 +279,17 @@ static mp_raw_code_t *load_raw_code(mp_reader_t *reader, mp_module_context_t *co
     #endif
 
     if (kind == MP_CODE_BYTECODE) {
-        // Allocate memory for the bytecode
-        fun_data = m_new(uint8_t, fun_data_len);
-        // Load bytecode
-        read_bytes(reader, fun_data, fun_data_len);
+        // CIRCUITPY-CHANGE: bytecode is never modified, so it can be run in place
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+        fun_data = (uint8_t *)mp_reader_try_read_rom(reader, fun_data_len);
+        if (fun_data == NULL)
+        #endif
+        {
+            // Allocate memory for the bytecode
+            fun_data = m_new(uint8_t, fun_data_len);
+            // Load bytecode
+            read_bytes(reader, fun_data, fun_data_len);
+        }
 
     #if MICROPY_EMIT_MACHINE_CODE
     } else {
@@ -61,13 +61,18 @@
 #define MICROPY_ALLOC_QSTR_ENTRIES_INIT (10)
 
 // this must match the equivalent function in makeqstrdata.py
-size_t qstr_compute_hash(const byte *data, size_t len) {
+// CIRCUITPY-CHANGE: the unmasked hash is also used by the runtime qstr index
+static size_t qstr_compute_hash_full(const byte *data, size_t len) {
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
     size_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
-    hash &= Q_HASH_MASK;
+    return hash;
+}
+
+size_t qstr_compute_hash(const byte *data, size_t len) {
+    size_t hash = qstr_compute_hash_full(data, len) & Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
         hash++;
@@ -206,6 +211,10 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 void qstr_reset(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t *)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    #endif
 }
 
 void qstr_init(void) {
@@ -228,6 +237,59 @@ static const qstr_pool_t *find_qstr(qstr *q) {
     return pool;
 }
 
+#if MICROPY_ALLOC_QSTR_INDEX_INIT
+// CIRCUITPY-CHANGE: qstrs interned at runtime go into unsorted pools, so they
+// are also entered in an open-addressing hash table of qstr ids, kept at most
+// half full.  The table either covers every runtime qstr or is NULL (because
+// it couldn't be allocated), in which case the runtime pools are searched
+// sequentially.
+
+static void qstr_index_insert(qstr *index, size_t alloc, qstr q, size_t hash) {
+    size_t mask = alloc - 1;
+    size_t i = hash & mask;
+    while (index[i] != MP_QSTRnull) {
+        i = (i + 1) & mask;
+    }
+    index[i] = q;
+}
+
+// qstr_mutex must be taken while in this function
+static void qstr_index_rebuild(size_t new_alloc) {
+    // Table sizes double from the initial size, and probing masks with size - 1
+    MP_STATIC_ASSERT((MICROPY_ALLOC_QSTR_INDEX_INIT & (MICROPY_ALLOC_QSTR_INDEX_INIT - 1)) == 0);
+    qstr *index = m_new_maybe(qstr, new_alloc);
+    if (MP_STATE_VM(qstr_index) != NULL) {
+        m_del(qstr, MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc));
+    }
+    MP_STATE_VM(qstr_index) = index;
+    MP_STATE_VM(qstr_index_alloc) = index == NULL ? 0 : new_alloc;
+    if (index == NULL) {
+        return;
+    }
+    memset(index, 0, new_alloc * sizeof(qstr));
+    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != &CONST_POOL; pool = pool->prev) {
+        for (size_t at = 0; at < pool->len; at++) {
+            size_t hash = qstr_compute_hash_full((const byte *)pool->qstrs[at], pool->lengths[at]);
+            qstr_index_insert(index, new_alloc, pool->total_prev_len + at, hash);
+        }
+    }
+}
+
+static qstr qstr_index_find(const char *str, size_t str_len) {
+    const qstr *index = MP_STATE_VM(qstr_index);
+    size_t mask = MP_STATE_VM(qstr_index_alloc) - 1;
+    size_t i = qstr_compute_hash_full((const byte *)str, str_len) & mask;
+    for (; index[i] != MP_QSTRnull; i = (i + 1) & mask) {
+        qstr q = index[i];
+        const qstr_pool_t *pool = find_qstr(&q);
+        if (pool->lengths[q] == str_len && memcmp(pool->qstrs[q], str, str_len) == 0) {
+            return index[i];
+        }
+    }
+    return MP_QSTRnull;
+}
+#endif
+
 // qstr_mutex must be taken while in this function
 static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     #if MICROPY_QSTR_BYTES_IN_HASH
@@ -237,6 +299,10 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     DEBUG_printf("QSTR: add len=%d data=%.*s\n", len, len, q_ptr);
     #endif
 
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    bool new_pool = false;
+    #endif
+
     // make sure we have room in the pool for a new qstr
     if (MP_STATE_VM(last_pool)->len >= MP_STATE_VM(last_pool)->alloc) {
         size_t new_alloc = MP_STATE_VM(last_pool)->alloc * 2;
@@ -273,6 +339,9 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
         pool->len = 0;
         MP_STATE_VM(last_pool) = pool;
         DEBUG_printf("QSTR: allocate new pool of size %d\n", MP_STATE_VM(last_pool)->alloc);
+        #if MICROPY_ALLOC_QSTR_INDEX_INIT
+        new_pool = true;
+        #endif
     }
 
     // add the new qstr
@@ -284,6 +353,25 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     MP_STATE_VM(last_pool)->qstrs[at] = q_ptr;
     MP_STATE_VM(last_pool)->len++;
 
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    // CIRCUITPY-CHANGE: keep the runtime qstr index up to date.  If it couldn't
+    // be allocated, try again each time a new pool is needed.
+    size_t index_len = QSTR_TOTAL() - (CONST_POOL.total_prev_len + CONST_POOL.len);
+    size_t index_alloc = MP_STATE_VM(qstr_index_alloc);
+    if (MP_STATE_VM(qstr_index) != NULL && index_len * 2 <= index_alloc) {
+        qstr_index_insert(MP_STATE_VM(qstr_index), index_alloc, MP_STATE_VM(last_pool)->total_prev_len + at,
+            qstr_compute_hash_full((const byte *)q_ptr, len));
+    } else if (MP_STATE_VM(qstr_index) != NULL || new_pool) {
+        if (index_alloc < MICROPY_ALLOC_QSTR_INDEX_INIT) {
+            index_alloc = MICROPY_ALLOC_QSTR_INDEX_INIT;
+        }
+        while (index_len * 2 > index_alloc) {
+            index_alloc *= 2;
+        }
+        qstr_index_rebuild(index_alloc);
+    }
+    #endif
+
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + at;
 }
@@ -299,8 +387,21 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
     #endif
 
+    const qstr_pool_t *pool = MP_STATE_VM(last_pool);
+
+    #if MICROPY_ALLOC_QSTR_INDEX_INIT
+    // CIRCUITPY-CHANGE: runtime pools are covered by the index, if there is one
+    if (MP_STATE_VM(qstr_index) != NULL) {
+        qstr q = qstr_index_find(str, str_len);
+        if (q != MP_QSTRnull) {
+            return q;
+        }
+        pool = &CONST_POOL;
+    }
+    #endif
+
     // search pools for the data
-    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+    for (; pool != NULL; pool = pool->prev) {
         size_t low = 0;
         size_t high = pool->len - 1;
 
@@ -399,6 +500,21 @@ qstr qstr_from_strn(const char *str, size_t len) {
     return q;
 }
 
+// CIRCUITPY-CHANGE
+qstr qstr_from_strn_static(const char *str, size_t len) {
+    QSTR_ENTER();
+    qstr q = qstr_find_strn(str, len);
+    if (q == 0) {
+        if (len >= (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN))) {
+            QSTR_EXIT();
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("name too long"));
+        }
+        q = qstr_add(len, str);
+    }
+    QSTR_EXIT();
+    return q;
+}
+
 mp_uint_t qstr_hash(qstr q) {
     const qstr_pool_t *pool = find_qstr(&q);
     #if MICROPY_QSTR_BYTES_IN_HASH
@@ -33,6 +33,11 @@
 // it can be called again after returning MP_READER_EOF, and in that case must return MP_READER_EOF
 #define MP_READER_EOF ((mp_uint_t)(-1))
 
+// CIRCUITPY-CHANGE
+// free_len for mp_reader_new_mem() when the data stays valid and unchanged for
+// the life of the VM, so that it may be referenced instead of copied
+#define MP_READER_IS_ROM ((size_t)-1)
+
 typedef struct _mp_reader_t {
     void *data;
     mp_uint_t (*readbyte)(void *data);
@@ -40,6 +45,10 @@ typedef struct _mp_reader_t {
 } mp_reader_t;
 
 void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t free_len);
+// CIRCUITPY-CHANGE
+// Return a pointer to the next len bytes and skip over them, if the reader is
+// over MP_READER_IS_ROM data, otherwise return NULL without consuming anything
+const byte *mp_reader_try_read_rom(mp_reader_t *reader, size_t len);
 void mp_reader_new_file(mp_reader_t *reader, qstr filename);
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd);
 
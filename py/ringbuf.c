@@ -8,6 +8,9 @@
 
 // CIRCUITPY-CHANGE: API and implementation thoroughly reworked
 // No attempt to have atomic operations. Add guards if atomicity required.
+// The exception is ringbuf_spsc_t, which is safe for one producer and one consumer.
+
+#include <string.h>
 
 #include "ringbuf.h"
 
@@ -103,24 +106,150 @@ size_t ringbuf_num_filled(ringbuf_t *r) {
 // If the ring buffer fills up, not all bytes will be written.
 // Returns how many bytes were successfully written.
 size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        if (ringbuf_put(r, buf[i]) < 0) {
-            // If ringbuf is full, give up and return how many bytes
-            // we wrote so far.
-            return i;
-        }
+    size_t n = MIN(bufsize, r->size - r->used);
+    if (n == 0) {
+        return 0;
+    }
+    // Copy up to the end of the buffer, then whatever wraps around.
+    size_t first = MIN(n, r->size - r->next_write);
+    memcpy(r->buf + r->next_write, buf, first);
+    memcpy(r->buf, buf + first, n - first);
+    r->next_write += n;
+    if (r->next_write >= r->size) {
+        r->next_write -= r->size;
     }
-    return bufsize;
+    r->used += n;
+    return n;
 }
 
 // Returns how many bytes were fetched.
 size_t ringbuf_get_n(ringbuf_t *r, uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        int b = ringbuf_get(r);
-        if (b < 0) {
-            return i;
+    size_t n = MIN(bufsize, r->used);
+    if (n == 0) {
+        return 0;
+    }
+    size_t first = MIN(n, r->size - r->next_read);
+    memcpy(buf, r->buf + r->next_read, first);
+    memcpy(buf + first, r->buf, n - first);
+    r->next_read += n;
+    if (r->next_read >= r->size) {
+        r->next_read -= r->size;
+    }
+    r->used -= n;
+    return n;
+}
+
+// Each side reads the other side's index with acquire semantics and publishes
+// its own with release semantics, so buffer contents are never seen before the
+// index that covers them (or overwritten before the consumer is done with them).
+#define SPSC_LOAD_ACQUIRE(idx) __atomic_load_n(&(idx), __ATOMIC_ACQUIRE)
+#define SPSC_STORE_RELEASE(idx, val) __atomic_store_n(&(idx), (val), __ATOMIC_RELEASE)
+
+bool ringbuf_spsc_init(ringbuf_spsc_t *r, uint8_t *buf, size_t size) {
+    r->buf = buf;
+    r->size = size;
+    r->mask = size != 0 && (size & (size - 1)) == 0 ? size - 1 : 0;
+    r->read_idx = 0;
+    r->write_idx = 0;
+    return r->buf != NULL;
+}
+
+bool ringbuf_spsc_alloc(ringbuf_spsc_t *r, size_t size) {
+    return ringbuf_spsc_init(r, m_malloc(size), size);
+}
+
+void ringbuf_spsc_deinit(ringbuf_spsc_t *r) {
+    // As with ringbuf_deinit(), let gc take care of the storage.
+    ringbuf_spsc_init(r, NULL, 0);
+}
+
+// Offset into buf of an index.
+static inline uint32_t spsc_offset(const ringbuf_spsc_t *r, uint32_t idx) {
+    if (r->mask != 0) {
+        return idx & r->mask;
+    }
+    return idx >= r->size ? idx - r->size : idx;
+}
+
+static inline uint32_t spsc_advance(const ringbuf_spsc_t *r, uint32_t idx, size_t len) {
+    idx += len;
+    if (r->mask != 0) {
+        return idx & ((r->mask << 1) | 1);
+    }
+    return idx >= 2 * r->size ? idx - 2 * r->size : idx;
+}
+
+static inline size_t spsc_filled(const ringbuf_spsc_t *r, uint32_t read_idx, uint32_t write_idx) {
+    return write_idx >= read_idx ? write_idx - read_idx : write_idx + 2 * r->size - read_idx;
+}
+
+size_t ringbuf_spsc_num_filled(ringbuf_spsc_t *r) {
+    return spsc_filled(r, SPSC_LOAD_ACQUIRE(r->read_idx), SPSC_LOAD_ACQUIRE(r->write_idx));
+}
+
+size_t ringbuf_spsc_num_empty(ringbuf_spsc_t *r) {
+    return r->size - ringbuf_spsc_num_filled(r);
+}
+
+uint8_t *ringbuf_spsc_write_span(ringbuf_spsc_t *r, size_t *len) {
+    uint32_t write_idx = r->write_idx;
+    size_t space = r->size - spsc_filled(r, SPSC_LOAD_ACQUIRE(r->read_idx), write_idx);
+    uint32_t offset = spsc_offset(r, write_idx);
+    *len = MIN(space, r->size - offset);
+    return r->buf + offset;
+}
+
+void ringbuf_spsc_write_commit(ringbuf_spsc_t *r, size_t len) {
+    SPSC_STORE_RELEASE(r->write_idx, spsc_advance(r, r->write_idx, len));
+}
+
+// Returns how many bytes were written.
+size_t ringbuf_spsc_put_n(ringbuf_spsc_t *r, const uint8_t *buf, size_t bufsize) {
+    size_t total = 0;
+    // At most two spans: up to the end of the buffer and from its start.
+    for (int i = 0; i < 2 && total < bufsize; i++) {
+        size_t len;
+        uint8_t *span = ringbuf_spsc_write_span(r, &len);
+        len = MIN(len, bufsize - total);
+        if (len == 0) {
+            break;
         }
-        buf[i] = b;
+        memcpy(span, buf + total, len);
+        ringbuf_spsc_write_commit(r, len);
+        total += len;
     }
-    return bufsize;
+    return total;
+}
+
+const uint8_t *ringbuf_spsc_read_span(ringbuf_spsc_t *r, size_t *len) {
+    uint32_t read_idx = r->read_idx;
+    size_t filled = spsc_filled(r, read_idx, SPSC_LOAD_ACQUIRE(r->write_idx));
+    uint32_t offset = spsc_offset(r, read_idx);
+    *len = MIN(filled, r->size - offset);
+    return r->buf + offset;
+}
+
+void ringbuf_spsc_read_commit(ringbuf_spsc_t *r, size_t len) {
+    SPSC_STORE_RELEASE(r->read_idx, spsc_advance(r, r->read_idx, len));
+}
+
+// Returns how many bytes were fetched.
+size_t ringbuf_spsc_get_n(ringbuf_spsc_t *r, uint8_t *buf, size_t bufsize) {
+    size_t total = 0;
+    for (int i = 0; i < 2 && total < bufsize; i++) {
+        size_t len;
+        const uint8_t *span = ringbuf_spsc_read_span(r, &len);
+        len = MIN(len, bufsize - total);
+        if (len == 0) {
+            break;
+        }
+        memcpy(buf + total, span, len);
+        ringbuf_spsc_read_commit(r, len);
+        total += len;
+    }
+    return total;
+}
+
+void ringbuf_spsc_clear(ringbuf_spsc_t *r) {
+    SPSC_STORE_RELEASE(r->read_idx, SPSC_LOAD_ACQUIRE(r->write_idx));
 }
@@ -47,3 +47,38 @@ int ringbuf_put16(ringbuf_t *r, uint16_t v);
 
 int ringbuf_get_bytes(ringbuf_t *r, uint8_t *data, size_t data_len);
 int ringbuf_put_bytes(ringbuf_t *r, const uint8_t *data, size_t data_len);
+
+// Lock-free ring buffer for one producer and one consumer, such as an interrupt
+// handler filling it and the VM draining it. The producer only writes
+// write_idx and the consumer only writes read_idx, so neither side needs to
+// disable interrupts. Indices run from 0 to 2 * size - 1 so that a full buffer
+// can be told apart from an empty one. Power-of-two sizes wrap with a mask.
+typedef struct _ringbuf_spsc_t {
+    uint8_t *buf;
+    uint32_t size;
+    uint32_t mask; // size - 1 if size is a power of two, else 0
+    uint32_t read_idx;
+    uint32_t write_idx;
+} ringbuf_spsc_t;
+
+bool ringbuf_spsc_init(ringbuf_spsc_t *r, uint8_t *buf, size_t size);
+bool ringbuf_spsc_alloc(ringbuf_spsc_t *r, size_t size);
+void ringbuf_spsc_deinit(ringbuf_spsc_t *r);
+
+// May be called from either side.
+size_t ringbuf_spsc_num_filled(ringbuf_spsc_t *r);
+size_t ringbuf_spsc_num_empty(ringbuf_spsc_t *r);
+
+// Producer side. ringbuf_spsc_write_span() returns the contiguous free space
+// (possibly only part of it, if it wraps) and its length; fill some or all of
+// it and then publish the bytes written with ringbuf_spsc_write_commit().
+uint8_t *ringbuf_spsc_write_span(ringbuf_spsc_t *r, size_t *len);
+void ringbuf_spsc_write_commit(ringbuf_spsc_t *r, size_t len);
+size_t ringbuf_spsc_put_n(ringbuf_spsc_t *r, const uint8_t *buf, size_t bufsize);
+
+// Consumer side, used in the same way as the producer side.
+const uint8_t *ringbuf_spsc_read_span(ringbuf_spsc_t *r, size_t *len);
+void ringbuf_spsc_read_commit(ringbuf_spsc_t *r, size_t len);
+size_t ringbuf_spsc_get_n(ringbuf_spsc_t *r, uint8_t *buf, size_t bufsize);
+// Discard everything the producer has published so far.
+void ringbuf_spsc_clear(ringbuf_spsc_t *r);
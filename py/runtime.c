@@ -140,6 +140,18 @@ void mp_init(void) {
     }
     #endif
 
+    // CIRCUITPY-CHANGE: forget patterns compiled by the previous VM
+    #if MICROPY_PY_RE && MICROPY_PY_RE_CACHE_SIZE
+    for (size_t i = 0; i < MICROPY_PY_RE_CACHE_SIZE * 2; ++i) {
+        MP_STATE_VM(re_cache[i]) = MP_OBJ_NULL;
+    }
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_VFS_IMPORT_STAT_CACHE
+    MP_STATE_VM(vfs_import_stat_cache) = MP_OBJ_NULL;
+    #endif
+
     // CIRCUITPY-CHANGE: do not unmount /
     #if MICROPY_VFS && 0
     // initialise the VFS sub-system
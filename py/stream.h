@@ -46,6 +46,10 @@
 #define MP_STREAM_SET_DATA_OPTS (9)  // Set data/message options
 #define MP_STREAM_GET_FILENO    (10) // Get fileno of underlying file
 #define MP_STREAM_GET_BUFFER_SIZE (11) // Get preferred buffer size for file
+// CIRCUITPY-CHANGE
+#define MP_STREAM_GET_BUFFER_PTR (12) // Get pointer to file data that stays valid and unchanged for the life of the VM (arg is const void **), returns length
+// CIRCUITPY-CHANGE
+#define MP_STREAM_POLL_NOTIFIES (13) // Get the MP_STREAM_POLL_* flags whose setting is signalled by mp_stream_poll_notify()
 
 // These poll ioctl values are compatible with Linux
 #define MP_STREAM_POLL_RD       (0x0001)
@@ -54,6 +58,19 @@
 #define MP_STREAM_POLL_HUP      (0x0010)
 #define MP_STREAM_POLL_NVAL     (0x0020)
 
+// CIRCUITPY-CHANGE
+// Called by a stream, possibly from an interrupt, when it becomes ready for
+// any of the events it reports for MP_STREAM_POLL_NOTIFIES, having not been
+// ready when last polled.  This lets select.poll wait for such streams
+// without polling them repeatedly.
+#if MICROPY_PY_SELECT
+void mp_stream_poll_notify(mp_obj_t stream);
+#else
+static inline void mp_stream_poll_notify(mp_obj_t stream) {
+    (void)stream;
+}
+#endif
+
 // Argument structure for MP_STREAM_SEEK
 struct mp_stream_seek_t {
     // If whence == MP_SEEK_SET, offset should be treated as unsigned.
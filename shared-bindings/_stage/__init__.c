@@ -40,6 +40,8 @@
 //|     :param layers: A list of the :py:class:`~_stage.Layer` objects.
 //|     :type layers: list[Layer]
 //|     :param ~circuitpython_typing.WriteableBuffer buffer: A buffer to use for rendering.
+//|       Whole rows are rendered and sent at once when the buffer can hold
+//|       at least one scaled row of the fragment.
 //|     :param ~busdisplay.BusDisplay display: The display to use.
 //|     :param int scale: How many times should the image be scaled up.
 //|     :param int background: What color to display when nothing is there.
@@ -77,6 +79,7 @@ static mp_obj_t stage_render(size_t n_args, const mp_obj_t *args) {
     int16_t vx = mp_obj_get_int(args[8]);
     int16_t vy = mp_obj_get_int(args[9]);
     uint16_t background = 0;
+    mp_arg_validate_length_min(bufinfo.len, scale * 2, MP_QSTR_buffer);
 
     render_stage(x0, y0, x1, y1, vx, vy, layers, layers_size,
         buffer, buffer_size, display, scale, background);
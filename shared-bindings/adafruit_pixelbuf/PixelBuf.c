@@ -18,7 +18,6 @@
 
 #include "shared-bindings/adafruit_pixelbuf/PixelBuf.h"
 #include "shared-module/adafruit_pixelbuf/PixelBuf.h"
-#include "shared-bindings/digitalio/DigitalInOut.h"
 
 #if CIRCUITPY_ULAB
 #include "extmod/ulab/code/ndarray.h"
@@ -65,7 +64,7 @@ static void parse_byteorder(mp_obj_t byteorder_obj, pixelbuf_byteorder_details_t
 static mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
     enum { ARG_size, ARG_byteorder, ARG_brightness, ARG_auto_write, ARG_header, ARG_trailer };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_byteorder, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = MP_OBJ_NEW_QSTR(MP_QSTR_BGR) } },
         { MP_QSTR_brightness, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
         { MP_QSTR_auto_write, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
@@ -90,7 +89,7 @@ static mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         trailer_bufinfo.len = 0;
     }
 
-    float brightness = 1.0;
+    mp_float_t brightness = 1.0;
     if (args[ARG_brightness].u_obj != mp_const_none) {
         brightness = mp_obj_get_float(args[ARG_brightness].u_obj);
         if (brightness < 0) {
@@ -182,6 +181,29 @@ MP_PROPERTY_GETSET(pixelbuf_pixelbuf_brightness_obj,
     (mp_obj_t)&pixelbuf_pixelbuf_get_brightness_obj,
     (mp_obj_t)&pixelbuf_pixelbuf_set_brightness_obj);
 
+//|     gamma: float
+//|     """Gamma correction applied to each color value before `brightness`. Each value
+//|     is output as ``255 * (value / 255) ** gamma``, looked up in a table built when
+//|     `gamma` or `brightness` changes. The default of 1.0 leaves values unchanged.
+//|
+//|     When gamma is not 1.0, a second buffer will be used to store the color values
+//|     before they are adjusted."""
+static mp_obj_t pixelbuf_pixelbuf_obj_get_gamma(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(self_in));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_gamma_obj, pixelbuf_pixelbuf_obj_get_gamma);
+
+static mp_obj_t pixelbuf_pixelbuf_obj_set_gamma(mp_obj_t self_in, mp_obj_t value) {
+    mp_float_t gamma = mp_arg_validate_obj_float_non_negative(value, 1, MP_QSTR_gamma);
+    common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(self_in, gamma);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_set_gamma_obj, pixelbuf_pixelbuf_obj_set_gamma);
+
+MP_PROPERTY_GETSET(pixelbuf_pixelbuf_gamma_obj,
+    (mp_obj_t)&pixelbuf_pixelbuf_get_gamma_obj,
+    (mp_obj_t)&pixelbuf_pixelbuf_set_gamma_obj);
+
 //|     auto_write: bool
 //|     """Whether to automatically write the pixels after each update."""
 static mp_obj_t pixelbuf_pixelbuf_obj_get_auto_write(mp_obj_t self_in) {
@@ -246,6 +268,235 @@ static mp_obj_t pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t value) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_fill);
 
+// Parse the byteorder of a buffer of packed colors, defaulting to the PixelBuf's own.
+static void parse_byteorder_or_default(mp_obj_t self_in, mp_obj_t byteorder_obj, pixelbuf_byteorder_details_t *parsed) {
+    if (byteorder_obj == mp_const_none) {
+        byteorder_obj = common_hal_adafruit_pixelbuf_pixelbuf_get_byteorder_string(self_in);
+    }
+    parse_byteorder(byteorder_obj, parsed);
+}
+
+//|     def set_from_buffer(
+//|         self, buffer: ReadableBuffer, *, byteorder: Optional[str] = None, start: int = 0
+//|     ) -> None:
+//|         """Sets consecutive pixels, beginning with pixel ``start``, from the packed color
+//|         values in ``buffer``. This is much faster than assigning a sequence of tuples.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer buffer: Bytes of color values, one pixel after another
+//|         :param str byteorder: Byte order of each pixel in ``buffer``, such as "RGB", "GRBW" or "PBGR".
+//|           Defaults to the byteorder of this PixelBuf. When there is no ``W`` or ``P`` value, white
+//|           is 0 and DotStar brightness is full.
+//|         :param int start: Index of the first pixel to set
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_set_from_buffer(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_byteorder, ARG_start };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_byteorder, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+    };
+    mp_obj_t self_in = pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    pixelbuf_byteorder_details_t byteorder_details;
+    parse_byteorder_or_default(self_in, args[ARG_byteorder].u_obj, &byteorder_details);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.len % byteorder_details.bpp != 0) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Buffer must be a multiple of %d bytes"), byteorder_details.bpp);
+    }
+
+    size_t length = common_hal_adafruit_pixelbuf_pixelbuf_get_len(self_in);
+    size_t start = mp_arg_validate_int_range(args[ARG_start].u_int, 0, length, MP_QSTR_start);
+    size_t count = bufinfo.len / byteorder_details.bpp;
+    mp_arg_validate_length_max(count, length - start, MP_QSTR_buffer);
+
+    common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(self_in, start, bufinfo.buf, count, &byteorder_details);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_set_from_buffer_obj, 1, pixelbuf_pixelbuf_set_from_buffer);
+
+#if CIRCUITPY_PIXELBUF_EFFECTS
+//|     def rainbow(self, offset: float = 0, *, spread: float = 256) -> None:
+//|         """Fills the pixels with colors from `rainbowio.colorwheel`. The first pixel is
+//|         ``colorwheel(offset)`` and the rest advance evenly so that all of the pixels together
+//|         span ``spread`` of the 256 color wheel positions.
+//|
+//|         To animate, derive ``offset`` from the time, such as
+//|         ``pixels.rainbow(time.monotonic() * 64)`` to go around the wheel every four seconds.
+//|
+//|         :param float offset: Color wheel position of the first pixel
+//|         :param float spread: Color wheel positions covered by all of the pixels
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_rainbow(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_offset, ARG_spread };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_offset, MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+        { MP_QSTR_spread, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(256)} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    common_hal_adafruit_pixelbuf_pixelbuf_rainbow(pos_args[0],
+        mp_obj_get_float(args[ARG_offset].u_obj), mp_obj_get_float(args[ARG_spread].u_obj));
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_rainbow_obj, 1, pixelbuf_pixelbuf_rainbow);
+
+//|     def gradient(self, color1: PixelType, color2: PixelType) -> None:
+//|         """Fills the pixels with a gradient that starts at ``color1`` on the first pixel and
+//|         ends at ``color2`` on the last."""
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_gradient(mp_obj_t self_in, mp_obj_t color1, mp_obj_t color2) {
+    common_hal_adafruit_pixelbuf_pixelbuf_gradient(self_in, color1, color2);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(pixelbuf_pixelbuf_gradient_obj, pixelbuf_pixelbuf_gradient);
+
+//|     def chase(
+//|         self,
+//|         position: int,
+//|         color: PixelType,
+//|         *,
+//|         background: PixelType = 0,
+//|         size: int = 2,
+//|         spacing: int = 3,
+//|     ) -> None:
+//|         """Fills the pixels with a repeating pattern of ``size`` pixels of ``color`` followed by
+//|         ``spacing`` pixels of ``background``. One run of ``color`` starts at pixel ``position``.
+//|         Increase ``position`` by one each frame to move the pattern along the strip.
+//|
+//|         :param int position: Index of the first pixel of a run of ``color``
+//|         :param PixelType color: Color of the moving runs
+//|         :param PixelType background: Color of the pixels between runs
+//|         :param int size: Number of pixels in each run of ``color``
+//|         :param int spacing: Number of ``background`` pixels between runs
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_chase(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_position, ARG_color, ARG_background, ARG_size, ARG_spacing };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_position, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_color, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_background, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+        { MP_QSTR_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 2} },
+        { MP_QSTR_spacing, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 3} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t size = mp_arg_validate_int_min(args[ARG_size].u_int, 1, MP_QSTR_size);
+    size_t spacing = mp_arg_validate_int_min(args[ARG_spacing].u_int, 0, MP_QSTR_spacing);
+    common_hal_adafruit_pixelbuf_pixelbuf_chase(pos_args[0], args[ARG_position].u_int,
+        args[ARG_color].u_obj, args[ARG_background].u_obj, size, spacing);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_chase_obj, 1, pixelbuf_pixelbuf_chase);
+
+//|     def blend(
+//|         self,
+//|         frame1: ReadableBuffer,
+//|         frame2: ReadableBuffer,
+//|         fraction: float,
+//|         *,
+//|         byteorder: Optional[str] = None,
+//|     ) -> None:
+//|         """Sets every pixel to a mix of two frames of packed color values, laid out as for
+//|         `set_from_buffer`. A ``fraction`` of 0 shows ``frame1``, 1 shows ``frame2`` and values in
+//|         between fade from one to the other.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer frame1: Colors shown when ``fraction`` is 0
+//|         :param ~circuitpython_typing.ReadableBuffer frame2: Colors shown when ``fraction`` is 1
+//|         :param float fraction: Amount of ``frame2`` in the result, from 0 to 1
+//|         :param str byteorder: Byte order of each pixel in the frames. Defaults to the byteorder
+//|           of this PixelBuf.
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_blend(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_frame1, ARG_frame2, ARG_fraction, ARG_byteorder };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_frame1, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_frame2, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_fraction, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_byteorder, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+    };
+    mp_obj_t self_in = pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    pixelbuf_byteorder_details_t byteorder_details;
+    parse_byteorder_or_default(self_in, args[ARG_byteorder].u_obj, &byteorder_details);
+
+    size_t frame_len = common_hal_adafruit_pixelbuf_pixelbuf_get_len(self_in) * byteorder_details.bpp;
+    mp_buffer_info_t frame1, frame2;
+    mp_get_buffer_raise(args[ARG_frame1].u_obj, &frame1, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[ARG_frame2].u_obj, &frame2, MP_BUFFER_READ);
+    mp_arg_validate_length(frame1.len, frame_len, MP_QSTR_frame1);
+    mp_arg_validate_length(frame2.len, frame_len, MP_QSTR_frame2);
+    mp_float_t fraction = mp_arg_validate_obj_float_range(args[ARG_fraction].u_obj, 0, 1, MP_QSTR_fraction);
+
+    common_hal_adafruit_pixelbuf_pixelbuf_blend(self_in, frame1.buf, frame2.buf, &byteorder_details, fraction);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_blend_obj, 1, pixelbuf_pixelbuf_blend);
+
+//|     def cycle_palette(
+//|         self,
+//|         palette: Sequence[PixelType],
+//|         offset: int = 0,
+//|         *,
+//|         indices: Optional[ReadableBuffer] = None,
+//|     ) -> None:
+//|         """Sets each pixel to a color from ``palette``, rotated by ``offset`` entries. Pixel ``i``
+//|         is ``palette[(indices[i] + offset) % len(palette)]``. Increase ``offset`` each frame to
+//|         cycle the colors.
+//|
+//|         :param Sequence[PixelType] palette: Colors to cycle through
+//|         :param int offset: Number of entries to rotate the palette by
+//|         :param ~circuitpython_typing.ReadableBuffer indices: One byte palette index per pixel.
+//|           When not given, pixel ``i`` uses index ``i``.
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_cycle_palette(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_palette, ARG_offset, ARG_indices };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_palette, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_indices, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+    };
+    mp_obj_t self_in = pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t palette_len;
+    mp_obj_t *palette;
+    mp_obj_get_array(args[ARG_palette].u_obj, &palette_len, &palette);
+    mp_arg_validate_length_min(palette_len, 1, MP_QSTR_palette);
+
+    const uint8_t *indices = NULL;
+    if (args[ARG_indices].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_indices].u_obj, &bufinfo, MP_BUFFER_READ);
+        mp_arg_validate_length(bufinfo.len, common_hal_adafruit_pixelbuf_pixelbuf_get_len(self_in), MP_QSTR_indices);
+        indices = bufinfo.buf;
+    }
+
+    common_hal_adafruit_pixelbuf_pixelbuf_cycle_palette(self_in, palette, palette_len, args[ARG_offset].u_int, indices);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_cycle_palette_obj, 1, pixelbuf_pixelbuf_cycle_palette);
+#endif
+
 //|     @overload
 //|     def __getitem__(self, index: slice) -> PixelReturnSequence:
 //|         """Returns the pixel value at the given index as a tuple of (Red, Green, Blue[, White]) values
@@ -349,8 +600,17 @@ static const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_bpp), MP_ROM_PTR(&pixelbuf_pixelbuf_bpp_obj)},
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_str)},
+    { MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&pixelbuf_pixelbuf_gamma_obj)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
     { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    { MP_ROM_QSTR(MP_QSTR_set_from_buffer), MP_ROM_PTR(&pixelbuf_pixelbuf_set_from_buffer_obj)},
+    #if CIRCUITPY_PIXELBUF_EFFECTS
+    { MP_ROM_QSTR(MP_QSTR_rainbow), MP_ROM_PTR(&pixelbuf_pixelbuf_rainbow_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gradient), MP_ROM_PTR(&pixelbuf_pixelbuf_gradient_obj)},
+    { MP_ROM_QSTR(MP_QSTR_chase), MP_ROM_PTR(&pixelbuf_pixelbuf_chase_obj)},
+    { MP_ROM_QSTR(MP_QSTR_blend), MP_ROM_PTR(&pixelbuf_pixelbuf_blend_obj)},
+    { MP_ROM_QSTR(MP_QSTR_cycle_palette), MP_ROM_PTR(&pixelbuf_pixelbuf_cycle_palette_obj)},
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(pixelbuf_pixelbuf_locals_dict, pixelbuf_pixelbuf_locals_dict_table);
@@ -26,6 +26,8 @@ void common_hal_adafruit_pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *se
 uint8_t common_hal_adafruit_pixelbuf_pixelbuf_get_bpp(mp_obj_t self);
 mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_brightness(mp_obj_t self);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self, mp_float_t brightness);
+mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(mp_obj_t self);
+void common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(mp_obj_t self, mp_float_t gamma);
 bool common_hal_adafruit_pixelbuf_pixelbuf_get_auto_write(mp_obj_t self);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_auto_write(mp_obj_t self, bool auto_write);
 size_t common_hal_adafruit_pixelbuf_pixelbuf_get_len(mp_obj_t self_in);
@@ -35,5 +37,14 @@ void common_hal_adafruit_pixelbuf_pixelbuf_show(mp_obj_t self);
 mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_pixel(mp_obj_t self, size_t index);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel(mp_obj_t self, size_t index, mp_obj_t item);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t *values, mp_obj_tuple_t *flatten_to);
+void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(mp_obj_t self_in, size_t start, const uint8_t *buffer, size_t count, const pixelbuf_byteorder_details_t *byteorder);
 void common_hal_adafruit_pixelbuf_pixelbuf_parse_color(mp_obj_t self, mp_obj_t color, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(mp_obj_t self, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
+
+#if CIRCUITPY_PIXELBUF_EFFECTS
+void common_hal_adafruit_pixelbuf_pixelbuf_rainbow(mp_obj_t self, mp_float_t offset, mp_float_t spread);
+void common_hal_adafruit_pixelbuf_pixelbuf_gradient(mp_obj_t self, mp_obj_t color1, mp_obj_t color2);
+void common_hal_adafruit_pixelbuf_pixelbuf_chase(mp_obj_t self, mp_int_t position, mp_obj_t color, mp_obj_t background, size_t size, size_t spacing);
+void common_hal_adafruit_pixelbuf_pixelbuf_blend(mp_obj_t self, const uint8_t *frame1, const uint8_t *frame2, const pixelbuf_byteorder_details_t *byteorder, mp_float_t fraction);
+void common_hal_adafruit_pixelbuf_pixelbuf_cycle_palette(mp_obj_t self, const mp_obj_t *palette, size_t palette_len, mp_int_t offset, const uint8_t *indices);
+#endif
@@ -6,6 +6,7 @@
 
 #include <math.h>
 
+#include "py/binary.h"
 #include "py/runtime.h"
 #include "py/objnamedtuple.h"
 #include "shared-bindings/displayio/Bitmap.h"
@@ -44,6 +45,12 @@
 //|     Specific weights create different effects. For instance, these
 //|     weights represent a 3x3 gaussian blur: ``[1, 2, 1, 2, 4, 2, 1, 2, 1]``
 //|
+//|     Some kinds of weights are processed more quickly. If all the weights
+//|     are equal (a "box blur"), the time taken does not depend on the size of
+//|     the kernel. If the weights are "separable", like the gaussian blur
+//|     above, the time taken is proportional to the width of the kernel
+//|     rather than to the number of weights.
+//|
 //|     ``mul`` is number to multiply the convolution pixel results by.
 //|     If `None` (the default) is passed, the value of ``1/sum(weights)``
 //|     is used (or ``1`` if ``sum(weights)`` is ``0``). For most weights, his
@@ -732,6 +739,157 @@ static mp_obj_t bitmapfilter_blend(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_blend_obj, 0, bitmapfilter_blend);
 
+//|
+//|
+//| class ChannelStatistics:
+//|     """Statistics for one channel of an image, as returned by `statistics`
+//|
+//|     The ``histogram`` is an array with one count per possible channel
+//|     value: 32 entries for the red and blue channels of an RGB565 image, 64
+//|     for the green channel, and 256 for an L8 image.
+//|
+//|     ``mean``, ``stddev``, ``min`` and ``max`` are in the same units as the
+//|     histogram index, so for instance the red channel of an RGB565 image
+//|     ranges from 0 to 31.
+//|     """
+//|
+//|     histogram: array.array
+//|     mean: float
+//|     stddev: float
+//|     min: int
+//|     max: int
+//|
+static const mp_obj_namedtuple_type_t bitmapfilter_channel_statistics_type = {
+    NAMEDTUPLE_TYPE_BASE_AND_SLOTS(MP_QSTR_ChannelStatistics),
+    .n_fields = 5,
+    .fields = {
+        MP_QSTR_histogram,
+        MP_QSTR_mean,
+        MP_QSTR_stddev,
+        MP_QSTR_min,
+        MP_QSTR_max,
+    },
+};
+
+//| class BitmapStatistics:
+//|     """Statistics for an image, as returned by `statistics`
+//|
+//|     For an L8 image, ``r``, ``g`` and ``b`` are all the same object.
+//|     ``count`` is the number of pixels that were not excluded by the mask."""
+//|
+//|     r: ChannelStatistics
+//|     g: ChannelStatistics
+//|     b: ChannelStatistics
+//|     count: int
+//|
+static const mp_obj_namedtuple_type_t bitmapfilter_bitmap_statistics_type = {
+    NAMEDTUPLE_TYPE_BASE_AND_SLOTS(MP_QSTR_BitmapStatistics),
+    .n_fields = 4,
+    .fields = {
+        MP_QSTR_r,
+        MP_QSTR_g,
+        MP_QSTR_b,
+        MP_QSTR_count,
+    },
+};
+
+//| def statistics(
+//|     bitmap: displayio.Bitmap,
+//|     mask: displayio.Bitmap | None = None,
+//|     *,
+//|     integral: WriteableBuffer | None = None,
+//| ) -> BitmapStatistics:
+//|     """Compute per-channel histograms and statistics of an image
+//|
+//|     The ``bitmap`` must be in RGB565_SWAPPED format or be an 8-bit
+//|     greyscale (L8) image. All statistics are gathered in a single pass.
+//|
+//|     ``mask`` is another image to use as a pixel level mask for the operation.
+//|     The mask must be an image the same size as the image being operated on.
+//|     Pixels set to a non-zero value in the mask are left out of the statistics.
+//|
+//|     If ``integral`` is given, it must be a writable buffer of 4-byte unsigned
+//|     integers (typecode ``I``, or ``L`` where that is 4 bytes) with at least
+//|     ``(width + 1) * (height + 1)`` entries. It is filled with the summed-area
+//|     table of the image's luminance (or its value, for L8 images), with
+//|     masked pixels counting as 0. Entry ``S[y * (width + 1) + x]`` is the sum
+//|     of all pixels above and to the left of ``(x, y)``, so the sum over the
+//|     rectangle ``x1 <= x < x2``, ``y1 <= y < y2`` is
+//|     ``S[y2][x2] - S[y1][x2] - S[y2][x1] + S[y1][x1]`` regardless of its size.
+//|     This is useful for adaptive thresholding and comparing the brightness of
+//|     regions between frames.
+//|     """
+//|
+//|
+static mp_obj_t bitmapfilter_statistics(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bitmap, ARG_mask, ARG_integral };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_mask, MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
+        { MP_QSTR_integral, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
+
+    displayio_bitmap_t *mask = NULL;
+    if (args[ARG_mask].u_obj != mp_const_none) {
+        mp_arg_validate_type(args[ARG_mask].u_obj, &displayio_bitmap_type, MP_QSTR_mask);
+        mask = MP_OBJ_TO_PTR(args[ARG_mask].u_obj);
+        if (mask->width != bitmap->width || mask->height != bitmap->height) {
+            mp_raise_ValueError(MP_ERROR_TEXT("bitmap sizes must match"));
+        }
+    }
+
+    uint32_t *integral = NULL;
+    if (args[ARG_integral].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_integral].u_obj, &bufinfo, MP_BUFFER_WRITE);
+        char typecode = bufinfo.typecode;
+        if ((typecode != 'I' && typecode != 'L') || mp_binary_get_size('@', typecode, NULL) != sizeof(uint32_t)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("bad typecode"));
+        }
+        size_t needed = (size_t)(bitmap->width + 1) * (bitmap->height + 1);
+        mp_arg_validate_length_min(bufinfo.len / sizeof(uint32_t), needed, MP_QSTR_integral);
+        integral = bufinfo.buf;
+    }
+
+    bool is_rgb = bitmap->bits_per_value != 8;
+    static const uint16_t rgb565_bins[3] = { 32, 64, 32 };
+    bitmapfilter_channel_statistics_t stats[3] = {};
+    mp_obj_t histograms[3];
+    for (int i = 0; i < (is_rgb ? 3 : 1); i++) {
+        size_t bins = is_rgb ? rgb565_bins[i] : 256;
+        uint32_t *histogram = m_malloc(bins * sizeof(uint32_t));
+        histograms[i] = mp_obj_new_memoryview('I', bins, histogram);
+        stats[i].histogram = histogram;
+        stats[i].bins = bins;
+    }
+
+    size_t count = shared_module_bitmapfilter_statistics(bitmap, mask, stats, integral);
+
+    mp_obj_t channels[3];
+    for (int i = 0; i < 3; i++) {
+        if (!is_rgb && i > 0) {
+            channels[i] = channels[0];
+            continue;
+        }
+        mp_obj_t items[] = {
+            histograms[i],
+            mp_obj_new_float(stats[i].mean),
+            mp_obj_new_float(stats[i].stddev),
+            MP_OBJ_NEW_SMALL_INT(stats[i].min),
+            MP_OBJ_NEW_SMALL_INT(stats[i].max),
+        };
+        channels[i] = namedtuple_make_new((const mp_obj_type_t *)&bitmapfilter_channel_statistics_type, MP_ARRAY_SIZE(items), 0, items);
+    }
+    mp_obj_t items[] = { channels[0], channels[1], channels[2], mp_obj_new_int_from_uint(count) };
+    return namedtuple_make_new((const mp_obj_type_t *)&bitmapfilter_bitmap_statistics_type, MP_ARRAY_SIZE(items), 0, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_statistics_obj, 0, bitmapfilter_statistics);
+
 static const mp_rom_map_elem_t bitmapfilter_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_bitmapfilter) },
     { MP_ROM_QSTR(MP_QSTR_morph), MP_ROM_PTR(&bitmapfilter_morph_obj) },
@@ -745,6 +903,9 @@ static const mp_rom_map_elem_t bitmapfilter_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_ChannelMixerOffset), MP_ROM_PTR(&bitmapfilter_channel_mixer_offset_type) },
     { MP_ROM_QSTR(MP_QSTR_blend), MP_ROM_PTR(&bitmapfilter_blend_obj) },
     { MP_ROM_QSTR(MP_QSTR_blend_precompute), MP_ROM_PTR(&bitmapfilter_blend_precompute_obj) },
+    { MP_ROM_QSTR(MP_QSTR_statistics), MP_ROM_PTR(&bitmapfilter_statistics_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ChannelStatistics), MP_ROM_PTR(&bitmapfilter_channel_statistics_type) },
+    { MP_ROM_QSTR(MP_QSTR_BitmapStatistics), MP_ROM_PTR(&bitmapfilter_bitmap_statistics_type) },
 };
 static MP_DEFINE_CONST_DICT(bitmapfilter_module_globals, bitmapfilter_module_globals_table);
 
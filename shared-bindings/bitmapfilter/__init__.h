@@ -62,3 +62,19 @@ void shared_module_bitmapfilter_blend(
     displayio_bitmap_t *src2,
     displayio_bitmap_t *mask,
     const uint8_t lookup[4096]);
+
+typedef struct {
+    uint32_t *histogram;
+    size_t bins;
+    mp_float_t mean, stddev;
+    int min, max;
+} bitmapfilter_channel_statistics_t;
+
+// For RGB565 bitmaps stats[0..2] are the r, g, b channels with 32, 64 and 32 bins.
+// For L8 bitmaps only stats[0] is used, with 256 bins.
+// If non-NULL, integral must hold (width + 1) * (height + 1) entries.
+size_t shared_module_bitmapfilter_statistics(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    bitmapfilter_channel_statistics_t stats[3],
+    uint32_t *integral);
@@ -277,6 +277,10 @@ static mp_uint_t busio_uart_write(mp_obj_t self_in, const void *buf_in, mp_uint_
     return common_hal_busio_uart_write(self, buf, size, errcode);
 }
 
+MP_WEAK mp_uint_t common_hal_busio_uart_poll_notifies(busio_uart_obj_t *self) {
+    return 0;
+}
+
 static mp_uint_t busio_uart_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t arg, int *errcode) {
     busio_uart_obj_t *self = native_uart(self_in);
     check_for_deinit(self);
@@ -290,6 +294,8 @@ static mp_uint_t busio_uart_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t
         if ((flags & MP_STREAM_POLL_WR) && common_hal_busio_uart_ready_to_tx(self)) {
             ret |= MP_STREAM_POLL_WR;
         }
+    } else if (request == MP_STREAM_POLL_NOTIFIES) {
+        ret = common_hal_busio_uart_poll_notifies(self);
     } else {
         *errcode = MP_EINVAL;
         ret = MP_STREAM_ERROR;
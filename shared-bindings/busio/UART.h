@@ -46,5 +46,7 @@ extern void common_hal_busio_uart_set_timeout(busio_uart_obj_t *self, mp_float_t
 extern uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self);
 extern void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self);
 extern bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self);
+// Returns the MP_STREAM_POLL_* flags the port signals with mp_stream_poll_notify().
+extern mp_uint_t common_hal_busio_uart_poll_notifies(busio_uart_obj_t *self);
 
 extern void common_hal_busio_uart_never_reset(busio_uart_obj_t *self);
@@ -62,7 +62,8 @@ void displayio_tilegrid_validate_pixel_shader(mp_obj_t pixel_shader) {
 //|         convert the value and its location to a display native pixel color. This may be a simple color
 //|         palette lookup, a gradient, a pattern or a color transformer.
 //|
-//|         To save RAM usage, tile values are only allowed in the range from 0 to 255 inclusive (single byte values).
+//|         To save RAM usage, each tile value takes a single byte unless the bitmap has more than 256
+//|         tiles, in which case tile values take two bytes.
 //|
 //|         tile_width and tile_height match the height of the bitmap by default.
 //|
@@ -453,7 +454,7 @@ static mp_obj_t tilegrid_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t v
             return MP_OBJ_NULL; // op not supported
         } else {
             mp_int_t value = mp_obj_get_int(value_obj);
-            mp_arg_validate_int_range(value, 0, 255, MP_QSTR_tile);
+            mp_arg_validate_int_range(value, 0, 0xffff, MP_QSTR_tile);
 
             common_hal_displayio_tilegrid_set_tile(self, x, y, value);
         }
@@ -13,7 +13,7 @@ extern const mp_obj_type_t displayio_tilegrid_type;
 void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_t bitmap,
     uint16_t bitmap_width_in_tiles, uint16_t bitmap_height_in_tiles,
     mp_obj_t pixel_shader, uint16_t width, uint16_t height,
-    uint16_t tile_width, uint16_t tile_height, uint16_t x, uint16_t y, uint8_t default_tile);
+    uint16_t tile_width, uint16_t tile_height, uint16_t x, uint16_t y, uint16_t default_tile);
 
 bool common_hal_displayio_tilegrid_get_hidden(displayio_tilegrid_t *self);
 void common_hal_displayio_tilegrid_set_hidden(displayio_tilegrid_t *self, bool hidden);
@@ -43,9 +43,9 @@ uint16_t common_hal_displayio_tilegrid_get_height(displayio_tilegrid_t *self);
 uint16_t common_hal_displayio_tilegrid_get_tile_width(displayio_tilegrid_t *self);
 uint16_t common_hal_displayio_tilegrid_get_tile_height(displayio_tilegrid_t *self);
 
-uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
-void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index);
+uint16_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
+void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t tile_index);
 
 // Private API for scrolling the TileGrid.
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
-void common_hal_displayio_tilegrid_set_all_tiles(displayio_tilegrid_t *self, uint8_t tile_index);
+void common_hal_displayio_tilegrid_set_all_tiles(displayio_tilegrid_t *self, uint16_t tile_index);
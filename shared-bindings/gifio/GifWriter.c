@@ -101,6 +101,11 @@ MP_DEFINE_CONST_FUN_OBJ_1(gifio_gifwriter_deinit_obj, gifio_gifwriter_deinit);
 //|     def add_frame(self, bitmap: ReadableBuffer, delay: float = 0.1) -> None:
 //|         """Add a frame to the GIF.
 //|
+//|         After the first frame, only the rectangle containing pixels that changed
+//|         since the previous frame is stored, and unchanged pixels within it are
+//|         stored as transparent. This makes mostly-static content such as
+//|         screen recordings much smaller.
+//|
 //|         :param bitmap: The frame data
 //|         :param delay: The frame delay in seconds.  The GIF format rounds this to the nearest 1/100 second, and the largest permitted value is 655 seconds.
 //|         """
@@ -87,12 +87,19 @@
 //|
 //|     """
 //|
-//|     def __init__(self, file: str) -> None:
+//|     def __init__(
+//|         self, file: str, *, use_palette: bool = False, keyframe_interval: int = 0
+//|     ) -> None:
 //|         """Create an `OnDiskGif` object with the given file.
 //|         The GIF frames are decoded into RGB565 big-endian format.
 //|         `displayio` expects little-endian, so the example above uses `Colorspace.RGB565_SWAPPED`.
 //|
 //|         :param file file: The name of the GIF file.
+//|         :param bool use_palette: Decode into an 8-bit bitmap with a `palette` instead of RGB565
+//|         :param int keyframe_interval: If nonzero, keep a copy of the bitmap (and
+//|           `palette`, if used) every ``keyframe_interval`` frames so that `seek` does not
+//|           have to decode from the first frame. Each copy uses as much memory as `bitmap`,
+//|           plus 1 KiB for the palette.
 //|
 //|         If the image is too large it will be cropped at the bottom and right when displayed.
 //|
@@ -103,10 +110,11 @@
 //|         ...
 //|
 static mp_obj_t gifio_ondiskgif_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_filename, ARG_use_palette, NUM_ARGS };
+    enum { ARG_filename, ARG_use_palette, ARG_keyframe_interval, NUM_ARGS };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_use_palette, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_keyframe_interval, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
     };
     MP_STATIC_ASSERT(MP_ARRAY_SIZE(allowed_args) == NUM_ARGS);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -121,8 +129,9 @@ static mp_obj_t gifio_ondiskgif_make_new(const mp_obj_type_t *type, size_t n_arg
         mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
     }
 
+    mp_int_t keyframe_interval = mp_arg_validate_int_min(args[ARG_keyframe_interval].u_int, 0, MP_QSTR_keyframe_interval);
     gifio_ondiskgif_t *self = mp_obj_malloc(gifio_ondiskgif_t, &gifio_ondiskgif_type);
-    common_hal_gifio_ondiskgif_construct(self, MP_OBJ_TO_PTR(filename), args[ARG_use_palette].u_bool);
+    common_hal_gifio_ondiskgif_construct(self, MP_OBJ_TO_PTR(filename), args[ARG_use_palette].u_bool, keyframe_interval);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -215,6 +224,27 @@ static mp_obj_t gifio_ondiskgif_obj_next_frame(mp_obj_t self_in) {
 
 MP_DEFINE_CONST_FUN_OBJ_1(gifio_ondiskgif_next_frame_obj, gifio_ondiskgif_obj_next_frame);
 
+//|     def seek(self, frame: int) -> None:
+//|         """Go to ``frame`` so that the next call to `next_frame` loads it. `bitmap` is
+//|         updated to show the image as it was just before ``frame``.
+//|
+//|         Decoding resumes from the closest earlier keyframe (see ``keyframe_interval``),
+//|         or from the current frame when seeking forward.
+//|
+//|         :param int frame: The index of the frame, from 0 to `frame_count` - 1."""
+//|
+static mp_obj_t gifio_ondiskgif_obj_seek(mp_obj_t self_in, mp_obj_t frame_in) {
+    gifio_ondiskgif_t *self = MP_OBJ_TO_PTR(self_in);
+
+    check_for_deinit(self);
+    int32_t frame = mp_arg_validate_int_range(mp_obj_get_int(frame_in), 0,
+        common_hal_gifio_ondiskgif_get_frame_count(self) - 1, MP_QSTR_frame);
+    common_hal_gifio_ondiskgif_seek(self, frame);
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(gifio_ondiskgif_seek_obj, gifio_ondiskgif_obj_seek);
+
 
 //|     duration: float
 //|     """Returns the total duration of the GIF in seconds. (read only)"""
@@ -294,6 +324,7 @@ static const mp_rom_map_elem_t gifio_ondiskgif_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_palette), MP_ROM_PTR(&gifio_ondiskgif_palette_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&gifio_ondiskgif_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_next_frame), MP_ROM_PTR(&gifio_ondiskgif_next_frame_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&gifio_ondiskgif_seek_obj) },
     { MP_ROM_QSTR(MP_QSTR_duration), MP_ROM_PTR(&gifio_ondiskgif_duration_obj) },
     { MP_ROM_QSTR(MP_QSTR_frame_count), MP_ROM_PTR(&gifio_ondiskgif_frame_count_obj) },
     { MP_ROM_QSTR(MP_QSTR_min_delay), MP_ROM_PTR(&gifio_ondiskgif_min_delay_obj) },
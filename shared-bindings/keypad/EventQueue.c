@@ -6,6 +6,7 @@
 
 #include "py/stream.h"
 #include "py/mperrno.h"
+#include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -68,6 +69,47 @@ static mp_obj_t keypad_eventqueue_get_into(mp_obj_t self_in, mp_obj_t event_in)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_into_obj, keypad_eventqueue_get_into);
 
+//|     def get_many_into(self, buffer: WriteableBuffer) -> int:
+//|         """Remove as many queued key transition events as fit into ``buffer``, store them,
+//|         and return how many were stored.
+//|
+//|         Each event takes three consecutive elements of ``buffer``: the key number,
+//|         ``1`` if the key was pressed or ``0`` if it was released, and the timestamp,
+//|         as in `Event`. ``buffer`` must have elements of at least 32 bits, such as
+//|         ``array.array('L', ...)``, so that it can hold timestamps.
+//|
+//|         Like ``get_into()``, this does not allocate storage, and it empties a busy
+//|         queue in one call.
+//|
+//|         :return: The number of events stored; ``0`` if there were no queued events.
+//|         :rtype: int
+//|         """
+//|         ...
+//|
+static mp_obj_t keypad_eventqueue_get_many_into(mp_obj_t self_in, mp_obj_t buffer_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    char typecode = bufinfo.typecode;
+    switch (typecode) {
+        case 'i':
+        case 'I':
+        case 'l':
+        case 'L':
+        case 'q':
+        case 'Q':
+            break;
+        default:
+            mp_raise_ValueError(MP_ERROR_TEXT("bad typecode"));
+    }
+    size_t item_size = mp_binary_get_size('@', typecode, NULL);
+
+    size_t max_events = bufinfo.len / item_size / 3;
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_eventqueue_get_many_into(self, bufinfo.buf, typecode, max_events));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_many_into_obj, keypad_eventqueue_get_many_into);
+
 //|     def clear(self) -> None:
 //|         """Clear any queued key transition events. Also sets `overflowed` to ``False``."""
 //|         ...
@@ -122,6 +164,7 @@ static const mp_rom_map_elem_t keypad_eventqueue_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_clear),      MP_ROM_PTR(&keypad_eventqueue_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_get),        MP_ROM_PTR(&keypad_eventqueue_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_into),   MP_ROM_PTR(&keypad_eventqueue_get_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_many_into), MP_ROM_PTR(&keypad_eventqueue_get_many_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_overflowed), MP_ROM_PTR(&keypad_eventqueue_overflowed_obj) },
 };
 
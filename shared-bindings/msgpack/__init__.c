@@ -75,6 +75,10 @@
 //| ) -> None:
 //|     """Output object to stream in msgpack format.
 //|
+//|     Small writes are collected and written to the stream together.
+//|     `bytes`, `bytearray` and `array.array` objects are packed as bin
+//|     and their contents are written in one write.
+//|
 //|     :param object obj: Object to convert to msgpack format.
 //|     :param ~circuitpython_typing.ByteStream stream: stream to write to
 //|     :param Optional[~circuitpython_typing.Callable[[object], None]] default:
@@ -119,6 +123,9 @@ MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_obj, 0, mod_msgpack_pack);
 //|     :param Optional[bool] use_list: return array as list or tuple (use_list=False).
 //|
 //|     :return object: object read from stream.
+//|
+//|     Reading from a stream takes several small reads per object. When a
+//|     whole message is already in memory, `unpackb` is faster.
 //|     """
 //|     ...
 //|
@@ -142,12 +149,60 @@ static mp_obj_t mod_msgpack_unpack(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_unpack_obj, 0, mod_msgpack_unpack);
 
+//| def unpackb(
+//|     buffer: circuitpython_typing.ReadableBuffer,
+//|     *,
+//|     ext_hook: Union[Callable[[int, bytes], object], None] = None,
+//|     use_list: bool = True,
+//|     use_memoryview: bool = False,
+//| ) -> object:
+//|     """Unpack and return the one object held in buffer.
+//|
+//|     :param ~circuitpython_typing.ReadableBuffer buffer: the complete msgpack data
+//|     :param Optional[~circuitpython_typing.Callable[[int, bytes], object]] ext_hook: function called for objects in
+//|            msgpack ext format.
+//|     :param Optional[bool] use_list: return array as list or tuple (use_list=False).
+//|     :param Optional[bool] use_memoryview: return bin and str values as read-only
+//|            `memoryview` slices of buffer instead of copies. str values are then the
+//|            UTF-8 encoded bytes. Map keys are always copied. The slices share memory
+//|            with buffer, so they change if buffer is modified. If buffer's memory isn't
+//|            managed by the garbage collector, such as that of some native objects,
+//|            the memoryviews are of copies instead.
+//|
+//|     :return object: object read from buffer.
+//|
+//|     Raises `ValueError` if buffer holds more data than one object.
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t mod_msgpack_unpackb(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_ext_hook, ARG_use_list, ARG_use_memoryview };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ, },
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+        { MP_QSTR_use_memoryview, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !mp_obj_is_fun(hook) && !MP_OBJ_IS_METH(hook)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ext_hook is not a function"));
+    }
+
+    return common_hal_msgpack_unpackb(args[ARG_buffer].u_obj, hook, args[ARG_use_list].u_bool, args[ARG_use_memoryview].u_bool);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_unpackb_obj, 0, mod_msgpack_unpackb);
+
 
 static const mp_rom_map_elem_t msgpack_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_msgpack) },
     { MP_ROM_QSTR(MP_QSTR_ExtType), MP_ROM_PTR(&mod_msgpack_exttype_type) },
     { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&mod_msgpack_pack_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&mod_msgpack_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpackb), MP_ROM_PTR(&mod_msgpack_unpackb_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(msgpack_module_globals, msgpack_module_globals_table);
@@ -446,6 +446,10 @@ static mp_uint_t socket_write(mp_obj_t self_in, const void *buf, mp_uint_t size,
     return ret;
 }
 
+MP_WEAK mp_uint_t common_hal_socketpool_socket_poll_notifies(socketpool_socket_obj_t *self) {
+    return 0;
+}
+
 static mp_uint_t socket_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t arg, int *errcode) {
     socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_uint_t ret;
@@ -458,6 +462,8 @@ static mp_uint_t socket_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t arg
         if ((flags & MP_STREAM_POLL_WR) && common_hal_socketpool_writable(self)) {
             ret |= MP_STREAM_POLL_WR;
         }
+    } else if (request == MP_STREAM_POLL_NOTIFIES) {
+        ret = common_hal_socketpool_socket_poll_notifies(self);
     } else {
         *errcode = MP_EINVAL;
         ret = MP_STREAM_ERROR;
@@ -29,6 +29,8 @@ void common_hal_socketpool_socket_settimeout(socketpool_socket_obj_t *self, uint
 int common_hal_socketpool_socket_setsockopt(socketpool_socket_obj_t *self, int level, int optname, const void *value, size_t optlen);
 bool common_hal_socketpool_readable(socketpool_socket_obj_t *self);
 bool common_hal_socketpool_writable(socketpool_socket_obj_t *self);
+// Returns the MP_STREAM_POLL_* flags the port signals with mp_stream_poll_notify().
+mp_uint_t common_hal_socketpool_socket_poll_notifies(socketpool_socket_obj_t *self);
 
 // Non-allocating versions for internal use.
 int socketpool_socket_accept(socketpool_socket_obj_t *self, mp_obj_t *peer_out, socketpool_socket_obj_t *accepted);
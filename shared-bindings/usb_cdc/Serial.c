@@ -106,16 +106,14 @@ static mp_uint_t usb_cdc_serial_ioctl_stream(mp_obj_t self_in, mp_uint_t request
     switch (request) {
         case MP_STREAM_POLL: {
             mp_uint_t flags = arg;
-            ret = 0;
-            if ((flags & MP_STREAM_POLL_RD) && common_hal_usb_cdc_serial_get_in_waiting(self) > 0) {
-                ret |= MP_STREAM_POLL_RD;
-            }
-            if ((flags & MP_STREAM_POLL_WR) && common_hal_usb_cdc_serial_get_out_waiting(self) == 0) {
-                ret |= MP_STREAM_POLL_WR;
-            }
+            ret = common_hal_usb_cdc_serial_poll(self) & flags;
             break;
         }
 
+        case MP_STREAM_POLL_NOTIFIES:
+            ret = common_hal_usb_cdc_serial_poll_notifies(self);
+            break;
+
         case MP_STREAM_FLUSH:
             common_hal_usb_cdc_serial_flush(self);
             break;
@@ -15,6 +15,8 @@ extern size_t common_hal_usb_cdc_serial_write(usb_cdc_serial_obj_t *self, const
 
 extern uint32_t common_hal_usb_cdc_serial_get_in_waiting(usb_cdc_serial_obj_t *self);
 extern uint32_t common_hal_usb_cdc_serial_get_out_waiting(usb_cdc_serial_obj_t *self);
+extern mp_uint_t common_hal_usb_cdc_serial_poll(usb_cdc_serial_obj_t *self);
+extern mp_uint_t common_hal_usb_cdc_serial_poll_notifies(usb_cdc_serial_obj_t *self);
 
 extern void common_hal_usb_cdc_serial_reset_input_buffer(usb_cdc_serial_obj_t *self);
 extern uint32_t common_hal_usb_cdc_serial_reset_output_buffer(usb_cdc_serial_obj_t *self);
@@ -83,3 +83,132 @@ uint16_t get_layer_pixel(layer_obj_t *layer, int16_t x, int16_t y) {
     // Convert to 16-bit color using the palette.
     return layer->palette[pixel << 1] | layer->palette[(pixel << 1) + 1] << 8;
 }
+
+// Render the part of one screen row that falls on the layer into line, which
+// holds count pixels starting at screen column x. Only pixels that are still
+// TRANSPARENT get written, so layers must be rendered front to back. The
+// tile, its rotation and the palette are resolved once per tile row instead
+// of once per pixel. Returns the number of pixels that were filled.
+size_t render_layer_span(layer_obj_t *layer, int16_t x, int16_t y,
+    uint16_t *line, size_t count) {
+
+    // Shift by the layer's position offset.
+    int32_t ly = y - layer->y;
+    int32_t lx = x - layer->x;
+
+    // Bounds check.
+    if ((ly < 0) || (ly >= layer->height << 4)) {
+        return 0;
+    }
+    int32_t start = lx < 0 ? 0 : lx;
+    int32_t end = lx + (int32_t)count;
+    if (end > layer->width << 4) {
+        end = layer->width << 4;
+    }
+    if (start >= end) {
+        return 0;
+    }
+
+    uint16_t colors[16];
+    for (uint8_t i = 0; i < 16; ++i) {
+        colors[i] = layer->palette[i << 1] | layer->palette[(i << 1) + 1] << 8;
+    }
+
+    uint8_t ty = ly >> 4;
+    int8_t py = ly & 0x0f;
+    size_t filled = 0;
+    for (int32_t tile_x = start; tile_x < end;) {
+        int32_t tile_end = (tile_x | 0x0f) + 1;
+        if (tile_end > end) {
+            tile_end = end;
+        }
+
+        // Get the tile from the grid location or from sprite frame.
+        uint8_t frame = layer->frame;
+        if (layer->map) {
+            uint8_t tx = tile_x >> 4;
+            frame = layer->map[(ty * layer->width + tx) >> 1];
+            if (tx & 0x01) {
+                frame &= 0x0f;
+            } else {
+                frame >>= 4;
+            }
+        }
+        const uint8_t *tile = &layer->graphic[frame << 7];
+
+        // Position in the rotated image of the first pixel of the span, and
+        // how it moves for each pixel to the right.
+        int8_t px = tile_x & 0x0f;
+        int8_t gx, gy, dx, dy;
+        switch (layer->rotation) {
+            case 1: // 90 degrees clockwise
+                gx = py;
+                gy = 15 - px;
+                dx = 0;
+                dy = -1;
+                break;
+            case 2: // 180 degrees
+                gx = 15 - px;
+                gy = 15 - py;
+                dx = -1;
+                dy = 0;
+                break;
+            case 3: // 90 degrees counter-clockwise
+                gx = 15 - py;
+                gy = px;
+                dx = 0;
+                dy = 1;
+                break;
+            case 4: // 0 degrees, mirrored
+                gx = 15 - px;
+                gy = py;
+                dx = -1;
+                dy = 0;
+                break;
+            case 5: // 90 degrees clockwise, mirrored
+                gx = py;
+                gy = px;
+                dx = 0;
+                dy = 1;
+                break;
+            case 6: // 180 degrees, mirrored
+                gx = px;
+                gy = 15 - py;
+                dx = 1;
+                dy = 0;
+                break;
+            case 7: // 90 degrees counter-clockwise, mirrored
+                gx = 15 - py;
+                gy = 15 - px;
+                dx = 0;
+                dy = -1;
+                break;
+            default: // 0 degrees
+                gx = px;
+                gy = py;
+                dx = 1;
+                dy = 0;
+                break;
+        }
+
+        uint16_t *out = &line[tile_x - lx];
+        for (int32_t i = tile_x; i < tile_end; ++i, ++out, gx += dx, gy += dy) {
+            if (*out != TRANSPARENT) {
+                continue;
+            }
+            uint8_t pixel = tile[(gy << 3) + (gx >> 1)];
+            if (gx & 0x01) {
+                pixel &= 0x0f;
+            } else {
+                pixel >>= 4;
+            }
+            uint16_t c = colors[pixel];
+            if (c != TRANSPARENT) {
+                *out = c;
+                filled += 1;
+            }
+        }
+        tile_x = tile_end;
+    }
+    return filled;
+}
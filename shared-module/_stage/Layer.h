@@ -23,3 +23,5 @@ typedef struct {
 } layer_obj_t;
 
 uint16_t get_layer_pixel(layer_obj_t *layer, int16_t x, int16_t y);
+size_t render_layer_span(layer_obj_t *layer, int16_t x, int16_t y,
+    uint16_t *line, size_t count);
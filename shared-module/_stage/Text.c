@@ -45,3 +45,70 @@ uint16_t get_text_pixel(text_obj_t *text, int16_t x, int16_t y) {
     // Convert to 16-bit color using the palette.
     return text->palette[pixel << 1] | text->palette[(pixel << 1) + 1] << 8;
 }
+
+// Render the part of one screen row that falls on the text into line, the
+// same way as render_layer_span(), one character row at a time.
+size_t render_text_span(text_obj_t *text, int16_t x, int16_t y,
+    uint16_t *line, size_t count) {
+
+    // Shift by the text's position offset.
+    int32_t ly = y - text->y;
+    int32_t lx = x - text->x;
+
+    // Bounds check.
+    if ((ly < 0) || (ly >= text->height << 3)) {
+        return 0;
+    }
+    int32_t start = lx < 0 ? 0 : lx;
+    int32_t end = lx + (int32_t)count;
+    if (end > text->width << 3) {
+        end = text->width << 3;
+    }
+    if (start >= end) {
+        return 0;
+    }
+
+    uint16_t colors[8];
+    for (uint8_t i = 0; i < 8; ++i) {
+        colors[i] = text->palette[i << 1] | text->palette[(i << 1) + 1] << 8;
+    }
+
+    const uint8_t *chars = &text->chars[(ly >> 3) * text->width];
+    uint8_t py = ly & 0x07;
+    size_t filled = 0;
+    for (int32_t char_x = start; char_x < end;) {
+        int32_t char_end = (char_x | 0x07) + 1;
+        if (char_end > end) {
+            char_end = end;
+        }
+
+        uint8_t c = chars[char_x >> 3];
+        uint8_t color_offset = 0;
+        if (c & 0x80) {
+            color_offset = 4;
+        }
+        c &= 0x7f;
+        if (!c) {
+            char_x = char_end;
+            continue;
+        }
+
+        const uint8_t *glyph_row = &text->font[(c << 4) + (py << 1)];
+        uint16_t *out = &line[char_x - lx];
+        for (int32_t i = char_x; i < char_end; ++i, ++out) {
+            if (*out != TRANSPARENT) {
+                continue;
+            }
+            uint8_t px = i & 0x07;
+            uint8_t pixel = glyph_row[px >> 2];
+            pixel = ((pixel >> ((px & 0x03) << 1)) & 0x03) + color_offset;
+            uint16_t color = colors[pixel];
+            if (color != TRANSPARENT) {
+                *out = color;
+                filled += 1;
+            }
+        }
+        char_x = char_end;
+    }
+    return filled;
+}
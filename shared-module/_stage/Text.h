@@ -21,3 +21,5 @@ typedef struct {
 } text_obj_t;
 
 uint16_t get_text_pixel(text_obj_t *text, int16_t x, int16_t y);
+size_t render_text_span(text_obj_t *text, int16_t x, int16_t y,
+    uint16_t *line, size_t count);
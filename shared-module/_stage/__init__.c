@@ -4,6 +4,8 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "Layer.h"
 #include "Text.h"
 #include "__init__.h"
@@ -11,6 +13,50 @@
 #include "shared-bindings/_stage/Text.h"
 
 
+// Render count pixels of the screen row y, starting at column x, into line.
+static void render_row(uint16_t *line, int16_t x, int16_t y, size_t count,
+    mp_obj_t *layers, size_t layers_size, uint16_t background) {
+    for (size_t i = 0; i < count; ++i) {
+        line[i] = TRANSPARENT;
+    }
+    // The layers are in front-to-back order, stop as soon as the row is full.
+    size_t remaining = count;
+    for (size_t layer = 0; layer < layers_size && remaining; ++layer) {
+        layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
+        if (obj->base.type == &mp_type_layer) {
+            remaining -= render_layer_span(obj, x, y, line, count);
+        } else if (obj->base.type == &mp_type_text) {
+            remaining -= render_text_span((text_obj_t *)obj, x, y, line, count);
+        }
+    }
+    if (remaining) {
+        for (size_t i = 0; i < count; ++i) {
+            if (line[i] == TRANSPARENT) {
+                line[i] = background;
+            }
+        }
+    }
+}
+
+// Repeat every pixel of the row scale times, in place.
+static void scale_row(uint16_t *line, size_t count, uint8_t scale) {
+    if (scale < 2) {
+        return;
+    }
+    for (size_t i = count; i-- > 0;) {
+        uint16_t c = line[i];
+        for (uint8_t xscale = 0; xscale < scale; ++xscale) {
+            line[i * scale + xscale] = c;
+        }
+    }
+}
+
+static void send_pixels(busdisplay_busdisplay_obj_t *display,
+    uint16_t *buffer, size_t size) {
+    display->bus.send(display->bus.bus, DISPLAY_DATA,
+        CHIP_SELECT_UNTOUCHED, ((uint8_t *)buffer), size * 2);
+}
+
 void render_stage(
     uint16_t x0, uint16_t y0,
     uint16_t x1, uint16_t y1,
@@ -34,45 +80,53 @@ void render_stage(
     display->bus.send(display->bus.bus, DISPLAY_COMMAND,
         CHIP_SELECT_TOGGLE_EVERY_BYTE,
         &display->write_ram_command, 1);
-    size_t index = 0;
-    for (int16_t y = y0 + vy; y < y1 + vy; ++y) {
-        for (uint8_t yscale = 0; yscale < scale; ++yscale) {
-            for (int16_t x = x0 + vx; x < x1 + vx; ++x) {
-                uint16_t c = TRANSPARENT;
-                for (size_t layer = 0; layer < layers_size; ++layer) {
-                    layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
-                    if (obj->base.type == &mp_type_layer) {
-                        c = get_layer_pixel(obj, x, y);
-                    } else if (obj->base.type == &mp_type_text) {
-                        c = get_text_pixel((text_obj_t *)obj, x, y);
-                    }
-                    if (c != TRANSPARENT) {
-                        break;
-                    }
-                }
-                if (c == TRANSPARENT) {
-                    c = background;
+
+    size_t width = x1 > x0 ? x1 - x0 : 0;
+    size_t row_size = width * scale;
+    if (row_size && row_size <= buffer_size) {
+        // Render each row once, scale it up in place and pack as many rows
+        // as fit into the buffer before sending it.
+        size_t index = 0;
+        for (int16_t y = y0 + vy; y < y1 + vy; ++y) {
+            if (index + row_size > buffer_size) {
+                send_pixels(display, buffer, index);
+                index = 0;
+            }
+            uint16_t *row = &buffer[index];
+            render_row(row, x0 + vx, y, width, layers, layers_size, background);
+            scale_row(row, width, scale);
+            index += row_size;
+            for (uint8_t yscale = 1; yscale < scale; ++yscale) {
+                if (index + row_size > buffer_size) {
+                    send_pixels(display, buffer, index);
+                    memmove(buffer, row, row_size * 2);
+                    row = buffer;
+                    index = row_size;
+                } else {
+                    memcpy(&buffer[index], row, row_size * 2);
+                    index += row_size;
                 }
-                for (uint8_t xscale = 0; xscale < scale; ++xscale) {
-                    buffer[index] = c;
-                    index += 1;
-                    // The buffer is full, send it.
-                    if (index >= buffer_size) {
-                        display->bus.send(display->bus.bus, DISPLAY_DATA,
-                            CHIP_SELECT_UNTOUCHED,
-                            ((uint8_t *)buffer), buffer_size * 2);
-                        index = 0;
-                    }
+            }
+        }
+        // Send the remaining data.
+        if (index) {
+            send_pixels(display, buffer, index);
+        }
+    } else if (row_size) {
+        // The buffer is smaller than a row, render it in pieces.
+        size_t piece = buffer_size / scale;
+        for (int16_t y = y0 + vy; y < y1 + vy; ++y) {
+            for (uint8_t yscale = 0; yscale < scale; ++yscale) {
+                for (size_t x = 0; x < width; x += piece) {
+                    size_t count = width - x < piece ? width - x : piece;
+                    render_row(buffer, x0 + vx + x, y, count, layers,
+                        layers_size, background);
+                    scale_row(buffer, count, scale);
+                    send_pixels(display, buffer, count * scale);
                 }
             }
         }
     }
-    // Send the remaining data.
-    if (index) {
-        display->bus.send(display->bus.bus, DISPLAY_DATA,
-            CHIP_SELECT_UNTOUCHED,
-            ((uint8_t *)buffer), index * 2);
-    }
 
     displayio_display_bus_end_transaction(&display->bus);
 }
@@ -5,11 +5,15 @@
 // SPDX-License-Identifier: MIT
 
 
+#include "py/binary.h"
 #include "py/obj.h"
 #include "py/objstr.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
 #include "shared-bindings/adafruit_pixelbuf/PixelBuf.h"
+#if CIRCUITPY_PIXELBUF_EFFECTS
+#include "shared-bindings/rainbowio/__init__.h"
+#endif
 #include <string.h>
 #include <math.h>
 
@@ -46,7 +50,10 @@ void common_hal_adafruit_pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *se
         }
     }
     // Call set_brightness so that it can allocate a second buffer if needed.
+    self->pre_brightness_buffer = NULL;
+    self->brightness_lut = NULL;
     self->brightness = 1.0;
+    self->gamma = 1.0;
     self->scaled_brightness = 0x100;
     common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(MP_OBJ_FROM_PTR(self), brightness);
 
@@ -84,6 +91,48 @@ mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_brightness(mp_obj_t self_in
     return self->brightness;
 }
 
+// Apply brightness_lut to pixel_len bytes of pre_brightness_buffer starting at offset.
+static void pixelbuf_apply_lut(pixelbuf_pixelbuf_obj_t *self, size_t offset, size_t pixel_len) {
+    const uint8_t *lut = self->brightness_lut;
+    const uint8_t *src = self->pre_brightness_buffer + offset;
+    uint8_t *dest = self->post_brightness_buffer + offset;
+    if (self->byteorder.is_dotstar) {
+        // Don't adjust per-pixel luminance bytes in dotstar mode
+        for (size_t i = 0; i < pixel_len; i += 4) {
+            dest[i] = src[i];
+            dest[i + 1] = lut[src[i + 1]];
+            dest[i + 2] = lut[src[i + 2]];
+            dest[i + 3] = lut[src[i + 3]];
+        }
+    } else {
+        for (size_t i = 0; i < pixel_len; i++) {
+            dest[i] = lut[src[i]];
+        }
+    }
+}
+
+// Rebuild brightness_lut after a brightness or gamma change and rescale the pixels with it.
+static void pixelbuf_update_scaling(pixelbuf_pixelbuf_obj_t *self) {
+    size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
+    if (self->pre_brightness_buffer == NULL) {
+        // No second buffer is needed until the values are changed.
+        if (self->scaled_brightness == 0x100 && self->gamma == 1) {
+            return;
+        }
+        self->pre_brightness_buffer = m_malloc(pixel_len);
+        memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
+        self->brightness_lut = m_malloc(256);
+    }
+    for (size_t i = 0; i < 256; i++) {
+        uint32_t value = i;
+        if (self->gamma != 1) {
+            value = (uint32_t)(MICROPY_FLOAT_C_FUN(pow)(i / (mp_float_t)255, self->gamma) * 255 + (mp_float_t)0.5);
+        }
+        self->brightness_lut[i] = (value * self->scaled_brightness) / 256;
+    }
+    pixelbuf_apply_lut(self, 0, pixel_len);
+}
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_float_t brightness) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
     // Skip out if the brightness is already set. The default of self->brightness is 1.0. So, this
@@ -95,25 +144,28 @@ void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_f
         return;
     }
     self->scaled_brightness = new_scaled_brightness;
-    size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
-    if (self->scaled_brightness == 0x100 && !self->pre_brightness_buffer) {
-        return;
-    } else {
-        if (self->pre_brightness_buffer == NULL) {
-            self->pre_brightness_buffer = m_malloc(pixel_len);
-            memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
-        }
-        for (size_t i = 0; i < pixel_len; i++) {
-            // Don't adjust per-pixel luminance bytes in dotstar mode
-            if (self->byteorder.is_dotstar && i % 4 == 0) {
-                continue;
-            }
-            self->post_brightness_buffer[i] = (self->pre_brightness_buffer[i] * self->scaled_brightness) / 256;
-        }
+    bool had_buffer = self->pre_brightness_buffer != NULL;
+    pixelbuf_update_scaling(self);
+    if ((had_buffer || self->pre_brightness_buffer != NULL) && self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
 
-        if (self->auto_write) {
-            common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
-        }
+mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(mp_obj_t self_in) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    return self->gamma;
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(mp_obj_t self_in, mp_float_t gamma) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    if (gamma == self->gamma) {
+        return;
+    }
+    self->gamma = gamma;
+    bool had_buffer = self->pre_brightness_buffer != NULL;
+    pixelbuf_update_scaling(self);
+    if ((had_buffer || self->pre_brightness_buffer != NULL) && self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
     }
 }
 
@@ -157,7 +209,7 @@ static void pixelbuf_parse_color(pixelbuf_pixelbuf_obj_t *self, mp_obj_t color,
         *b = _pixelbuf_get_as_uint8(items[PIXEL_B]);
         if (len > 3) {
             if (mp_obj_is_float(items[PIXEL_W])) {
-                *w = 255 * mp_obj_get_float(items[PIXEL_W]);
+                *w = (uint8_t)(255 * mp_obj_get_float(items[PIXEL_W]));
             } else {
                 *w = mp_obj_get_int_truncated(items[PIXEL_W]);
             }
@@ -205,15 +257,16 @@ static void pixelbuf_set_pixel_color(pixelbuf_pixelbuf_obj_t *self, size_t index
     unscaled_buffer[rgbw_order->b] = b;
 
     if (scaled_buffer) {
+        const uint8_t *lut = self->brightness_lut;
         if (self->bytes_per_pixel == 4) {
             if (!self->byteorder.is_dotstar) {
-                w = (w * self->scaled_brightness) / 256;
+                w = lut[w];
             }
             scaled_buffer[rgbw_order->w] = w;
         }
-        scaled_buffer[rgbw_order->r] = (r * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->g] = (g * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->b] = (b * self->scaled_brightness) / 256;
+        scaled_buffer[rgbw_order->r] = lut[r];
+        scaled_buffer[rgbw_order->g] = lut[g];
+        scaled_buffer[rgbw_order->b] = lut[b];
     }
 }
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(mp_obj_t self_in, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
@@ -230,9 +283,74 @@ static void _pixelbuf_set_pixel(pixelbuf_pixelbuf_obj_t *self, size_t index, mp_
     common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(self, index, r, g, b, w);
 }
 
+// Store count pixels from buffer, which is laid out as described by byteorder, starting at
+// pixel start.
+static void pixelbuf_set_pixels_from_buffer(pixelbuf_pixelbuf_obj_t *self, size_t start, const uint8_t *buffer,
+    size_t count, const pixelbuf_byteorder_details_t *byteorder) {
+    const pixelbuf_rgbw_t *src_order = &byteorder->byteorder;
+    const pixelbuf_rgbw_t *dest_order = &self->byteorder.byteorder;
+    size_t src_bpp = byteorder->bpp;
+    size_t dest_bpp = self->bytes_per_pixel;
+    bool is_dotstar = self->byteorder.is_dotstar;
+    size_t offset = start * dest_bpp;
+    size_t pixel_len = count * dest_bpp;
+    uint8_t *unscaled_buffer = self->pre_brightness_buffer ? self->pre_brightness_buffer : self->post_brightness_buffer;
+    unscaled_buffer += offset;
+
+    if (src_bpp == dest_bpp && !is_dotstar && !byteorder->is_dotstar &&
+        src_order->r == dest_order->r && src_order->g == dest_order->g && src_order->b == dest_order->b &&
+        (src_bpp == 3 || src_order->w == dest_order->w)) {
+        memcpy(unscaled_buffer, buffer, pixel_len);
+    } else {
+        // A missing fourth value is the same default as pixelbuf_parse_color() uses.
+        uint8_t default_w = is_dotstar ? 255 : 0;
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t *src = buffer + i * src_bpp;
+            uint8_t *dest = unscaled_buffer + i * dest_bpp;
+            dest[dest_order->r] = src[src_order->r];
+            dest[dest_order->g] = src[src_order->g];
+            dest[dest_order->b] = src[src_order->b];
+            if (dest_bpp == 4) {
+                uint8_t w = src_bpp == 4 ? src[src_order->w] : default_w;
+                if (is_dotstar) {
+                    w = DOTSTAR_LED_START | w >> 3;
+                }
+                dest[dest_order->w] = w;
+            }
+        }
+    }
+
+    if (self->pre_brightness_buffer) {
+        pixelbuf_apply_lut(self, offset, pixel_len);
+    }
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(mp_obj_t self_in, size_t start, const uint8_t *buffer,
+    size_t count, const pixelbuf_byteorder_details_t *byteorder) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    pixelbuf_set_pixels_from_buffer(self, start, buffer, count, byteorder);
+    if (self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t *values,
     mp_obj_tuple_t *flatten_to) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    mp_buffer_info_t bufinfo;
+    if (flatten_to != mp_const_none && step == 1 && !mp_obj_is_str(values) && mp_get_buffer(values, &bufinfo, MP_BUFFER_READ) &&
+        mp_binary_get_size('@', bufinfo.typecode, NULL) == 1) {
+        // Flattened R, G, B[, W] bytes can be copied in without making an object per value.
+        pixelbuf_byteorder_details_t flat_order = {
+            .bpp = self->bytes_per_pixel,
+            .byteorder = { .r = PIXEL_R, .g = PIXEL_G, .b = PIXEL_B, .w = PIXEL_W },
+        };
+        pixelbuf_set_pixels_from_buffer(self, start, bufinfo.buf, slice_len, &flat_order);
+        if (self->auto_write) {
+            common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+        }
+        return;
+    }
     mp_obj_iter_buf_t iter_buf;
     mp_obj_t iterable = mp_getiter(values, &iter_buf);
     mp_obj_t item;
@@ -319,3 +437,120 @@ void common_hal_adafruit_pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t fill_
         common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
     }
 }
+
+#if CIRCUITPY_PIXELBUF_EFFECTS
+// Effects write every pixel through pixelbuf_set_pixel_color() so brightness and gamma are
+// applied just as they are for assigned colors, and then show once if auto_write is set.
+
+static void pixelbuf_effect_done(mp_obj_t self_in, pixelbuf_pixelbuf_obj_t *self) {
+    if (self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
+
+static uint8_t pixelbuf_default_w(pixelbuf_pixelbuf_obj_t *self) {
+    return self->byteorder.is_dotstar ? 255 : 0;
+}
+
+static uint8_t pixelbuf_mix(uint8_t a, uint8_t b, uint32_t fraction) {
+    // fraction is 0 (all a) to 256 (all b).
+    return (a * (256 - fraction) + b * fraction) >> 8;
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_rainbow(mp_obj_t self_in, mp_float_t offset, mp_float_t spread) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    uint8_t w = pixelbuf_default_w(self);
+    mp_float_t step = self->pixel_count ? spread / self->pixel_count : 0;
+    // colorwheel() only handles non-negative positions.
+    offset = MICROPY_FLOAT_C_FUN(fmod)(offset, 256);
+    if (offset < 0) {
+        offset += 256;
+    }
+    for (size_t i = 0; i < self->pixel_count; i++) {
+        mp_float_t pos = MICROPY_FLOAT_C_FUN(fmod)(offset + i * step, 256);
+        if (pos < 0) {
+            pos += 256;
+        }
+        int32_t color = colorwheel(pos);
+        pixelbuf_set_pixel_color(self, i, color >> 16 & 0xff, (color >> 8) & 0xff, color & 0xff, w);
+    }
+    pixelbuf_effect_done(self_in, self);
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_gradient(mp_obj_t self_in, mp_obj_t color1, mp_obj_t color2) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    color_u c1, c2;
+    pixelbuf_parse_color(self, color1, &c1.r, &c1.g, &c1.b, &c1.w);
+    pixelbuf_parse_color(self, color2, &c2.r, &c2.g, &c2.b, &c2.w);
+    size_t last = self->pixel_count > 1 ? self->pixel_count - 1 : 1;
+    for (size_t i = 0; i < self->pixel_count; i++) {
+        uint32_t fraction = (i * 256 + last / 2) / last;
+        pixelbuf_set_pixel_color(self, i,
+            pixelbuf_mix(c1.r, c2.r, fraction), pixelbuf_mix(c1.g, c2.g, fraction),
+            pixelbuf_mix(c1.b, c2.b, fraction), pixelbuf_mix(c1.w, c2.w, fraction));
+    }
+    pixelbuf_effect_done(self_in, self);
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_chase(mp_obj_t self_in, mp_int_t position, mp_obj_t color,
+    mp_obj_t background, size_t size, size_t spacing) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    color_u fg, bg;
+    pixelbuf_parse_color(self, color, &fg.r, &fg.g, &fg.b, &fg.w);
+    pixelbuf_parse_color(self, background, &bg.r, &bg.g, &bg.b, &bg.w);
+    mp_int_t period = size + spacing;
+    // Index within the repeating pattern of the first pixel.
+    mp_int_t phase = -position % period;
+    if (phase < 0) {
+        phase += period;
+    }
+    for (size_t i = 0; i < self->pixel_count; i++) {
+        color_u *c = phase < (mp_int_t)size ? &fg : &bg;
+        pixelbuf_set_pixel_color(self, i, c->r, c->g, c->b, c->w);
+        if (++phase == period) {
+            phase = 0;
+        }
+    }
+    pixelbuf_effect_done(self_in, self);
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_blend(mp_obj_t self_in, const uint8_t *frame1, const uint8_t *frame2,
+    const pixelbuf_byteorder_details_t *byteorder, mp_float_t fraction) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    const pixelbuf_rgbw_t *order = &byteorder->byteorder;
+    size_t bpp = byteorder->bpp;
+    uint32_t scaled_fraction = (uint32_t)(fraction * 256 + (mp_float_t)0.5);
+    uint8_t default_w = pixelbuf_default_w(self);
+    for (size_t i = 0; i < self->pixel_count; i++) {
+        const uint8_t *a = frame1 + i * bpp;
+        const uint8_t *b = frame2 + i * bpp;
+        uint8_t w = bpp == 4 ? pixelbuf_mix(a[order->w], b[order->w], scaled_fraction) : default_w;
+        pixelbuf_set_pixel_color(self, i,
+            pixelbuf_mix(a[order->r], b[order->r], scaled_fraction),
+            pixelbuf_mix(a[order->g], b[order->g], scaled_fraction),
+            pixelbuf_mix(a[order->b], b[order->b], scaled_fraction), w);
+    }
+    pixelbuf_effect_done(self_in, self);
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_cycle_palette(mp_obj_t self_in, const mp_obj_t *palette, size_t palette_len,
+    mp_int_t offset, const uint8_t *indices) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    // Parse the palette once instead of once per pixel.
+    color_u *colors = m_new(color_u, palette_len);
+    for (size_t i = 0; i < palette_len; i++) {
+        pixelbuf_parse_color(self, palette[i], &colors[i].r, &colors[i].g, &colors[i].b, &colors[i].w);
+    }
+    offset %= (mp_int_t)palette_len;
+    if (offset < 0) {
+        offset += palette_len;
+    }
+    for (size_t i = 0; i < self->pixel_count; i++) {
+        size_t index = ((indices ? indices[i] : i) + offset) % palette_len;
+        color_u *c = &colors[index];
+        pixelbuf_set_pixel_color(self, i, c->r, c->g, c->b, c->w);
+    }
+    m_del(color_u, colors, palette_len);
+    pixelbuf_effect_done(self_in, self);
+}
+#endif
@@ -7,6 +7,8 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "py/runtime.h"
@@ -38,36 +40,39 @@ static void check_matching_details(displayio_bitmap_t *b1, displayio_bitmap_t *b
 size_t scratchpad_size = 0;
 static void *scratchpad = NULL;
 
-static void *scratchpad_alloc(size_t sz) {
+// Returns NULL if the scratchpad can't be grown to sz bytes, leaving the
+// previous scratchpad in place.
+static void *scratchpad_alloc_maybe(size_t sz) {
     if (sz == 0) {
         if (scratchpad) {
             port_free(scratchpad);
         }
         scratchpad_size = sz;
         scratchpad = NULL;
-    } else {
-        if (scratchpad) {
-            if (sz > scratchpad_size) {
-                void *tmp = port_realloc(scratchpad, sz);
-                if (!tmp) {
-                    port_free(scratchpad);
-                    scratchpad = NULL;
-                } else {
-                    scratchpad = tmp;
-                    scratchpad_size = sz;
-                }
+    } else if (scratchpad) {
+        if (sz > scratchpad_size) {
+            void *tmp = port_realloc(scratchpad, sz);
+            if (!tmp) {
+                return NULL;
             }
-        } else {
-            scratchpad = port_malloc(sz, false);
+            scratchpad = tmp;
             scratchpad_size = sz;
         }
-        if (!scratchpad) {
-            m_malloc_fail(sz);
-        }
+    } else {
+        scratchpad = port_malloc(sz, false);
+        scratchpad_size = scratchpad ? sz : 0;
     }
     return scratchpad;
 }
 
+static void *scratchpad_alloc(size_t sz) {
+    void *result = scratchpad_alloc_maybe(sz);
+    if (sz && !result) {
+        m_malloc_fail(sz);
+    }
+    return result;
+}
+
 static void scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols) {
     int stride = (cols + 1) / 2;
     size_t sz = rows * stride * sizeof(uint32_t);
@@ -88,6 +93,277 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v) {
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+typedef struct {
+    int32_t m_int, b_int;
+    int offset;
+    bool threshold, invert;
+} morph_params_t;
+
+// Scale, offset and clip the convolution result; optionally threshold it
+// against the original pixel.
+static inline int morph_finish_pixel(const morph_params_t *params, int32_t r_acc, int32_t g_acc, int32_t b_acc, int orig_pixel) {
+    r_acc = (r_acc * params->m_int + params->b_int) >> 16;
+    if (r_acc > COLOR_R5_MAX) {
+        r_acc = COLOR_R5_MAX;
+    } else if (r_acc < 0) {
+        r_acc = 0;
+    }
+    g_acc = (g_acc * params->m_int + params->b_int * 2) >> 16;
+    if (g_acc > COLOR_G6_MAX) {
+        g_acc = COLOR_G6_MAX;
+    } else if (g_acc < 0) {
+        g_acc = 0;
+    }
+    b_acc = (b_acc * params->m_int + params->b_int) >> 16;
+    if (b_acc > COLOR_B5_MAX) {
+        b_acc = COLOR_B5_MAX;
+    } else if (b_acc < 0) {
+        b_acc = 0;
+    }
+
+    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+
+    if (params->threshold) {
+        if (((COLOR_RGB565_TO_Y(pixel) - params->offset) < COLOR_RGB565_TO_Y(orig_pixel)) ^ params->invert) {
+            pixel = COLOR_RGB565_BINARY_MAX;
+        } else {
+            pixel = COLOR_RGB565_BINARY_MIN;
+        }
+    }
+    return pixel;
+}
+
+// A kernel whose weights are all the same nonzero value is a box filter
+static bool morph_kernel_is_box(int ksize, const int *krn) {
+    int n = (2 * ksize + 1) * (2 * ksize + 1);
+    if (krn[0] == 0) {
+        return false;
+    }
+    for (int i = 1; i < n; i++) {
+        if (krn[i] != krn[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check whether the kernel is the outer product of a column and a row vector,
+// i.e., krn[i][j] == vkrn[i] * hkrn[j] / divisor exactly. Gaussian kernels
+// such as [1, 2, 1, 2, 4, 2, 1, 2, 1] are separable. Kernels whose
+// vertical pass could overflow an int32_t accumulator are rejected.
+static bool morph_kernel_separate(int ksize, const int *krn, int *hkrn, int *vkrn, int32_t *divisor) {
+    int n = 2 * ksize + 1;
+    int pivot_row = -1, pivot_col = -1;
+    for (int i = 0; i < n * n; i++) {
+        if (krn[i]) {
+            pivot_row = i / n;
+            pivot_col = i % n;
+            break;
+        }
+    }
+    if (pivot_row < 0) {
+        return false;
+    }
+    int pivot = krn[pivot_row * n + pivot_col];
+    for (int i = 0; i < n; i++) {
+        hkrn[i] = krn[pivot_row * n + i];
+        vkrn[i] = krn[i * n + pivot_col];
+    }
+    int64_t hsum = 0, vsum = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if ((int64_t)krn[i * n + j] * pivot != (int64_t)vkrn[i] * hkrn[j]) {
+                return false;
+            }
+        }
+        hsum += llabs(hkrn[i]);
+        vsum += llabs(vkrn[i]);
+    }
+    if (hsum * COLOR_G6_MAX > INT32_MAX || vsum > INT32_MAX / (hsum * COLOR_G6_MAX)) {
+        return false;
+    }
+    *divisor = pivot;
+    return true;
+}
+
+// Unpack a row into r, g, b triples, extended by ksize pixels on each side
+// by repeating the edge pixels.
+static void morph_unpack_row(displayio_bitmap_t *bitmap, int y, int ksize, int32_t *out) {
+    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+    for (int x = -ksize, xx = bitmap->width + ksize; x < xx; x++) {
+        int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, IM_MIN(IM_MAX(x, 0), (bitmap->width - 1)));
+        *out++ = COLOR_RGB565_TO_R5(pixel);
+        *out++ = COLOR_RGB565_TO_G6(pixel);
+        *out++ = COLOR_RGB565_TO_B5(pixel);
+    }
+}
+
+static void morph_hconvolve(const int32_t *unpacked, int width, int ksize, const int *hkrn, int32_t *out) {
+    int n = 2 * ksize + 1;
+    for (int x = 0; x < width; x++) {
+        int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+        const int32_t *in = unpacked + 3 * x;
+        for (int k = 0; k < n; k++) {
+            r_acc += hkrn[k] * *in++;
+            g_acc += hkrn[k] * *in++;
+            b_acc += hkrn[k] * *in++;
+        }
+        *out++ = r_acc;
+        *out++ = g_acc;
+        *out++ = b_acc;
+    }
+}
+
+// Horizontal box sum using a running total, so the cost does not depend on ksize
+static void morph_hbox(const int32_t *unpacked, int width, int ksize, int32_t *out) {
+    int n = 2 * ksize + 1;
+    int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+    for (int k = 0; k < n; k++) {
+        r_acc += unpacked[3 * k];
+        g_acc += unpacked[3 * k + 1];
+        b_acc += unpacked[3 * k + 2];
+    }
+    for (int x = 0; x < width; x++) {
+        *out++ = r_acc;
+        *out++ = g_acc;
+        *out++ = b_acc;
+        if (x + 1 < width) {
+            const int32_t *enter = unpacked + 3 * (x + n), *leave = unpacked + 3 * x;
+            r_acc += enter[0] - leave[0];
+            g_acc += enter[1] - leave[1];
+            b_acc += enter[2] - leave[2];
+        }
+    }
+}
+
+// Convolve with a separable kernel as a horizontal pass followed by a
+// vertical pass, keeping the horizontal results of the last 2*ksize+1 rows.
+// Each output row only depends on the original contents of its own row once
+// those results exist, so it can be written back right away. Returns false,
+// without touching the bitmap, if there isn't enough memory.
+static bool morph_separable(displayio_bitmap_t *bitmap, displayio_bitmap_t *mask, int ksize,
+    const int *hkrn, const int *vkrn, int32_t divisor, const morph_params_t *params) {
+    int n = 2 * ksize + 1;
+    int width = bitmap->width, height = bitmap->height;
+    size_t row_len = 3 * width;
+    int32_t *rows = scratchpad_alloc_maybe((n * row_len + 3 * (width + 2 * ksize)) * sizeof(int32_t));
+    if (!rows) {
+        return false;
+    }
+    int32_t *unpacked = rows + n * row_len;
+
+    int next_row = 0; // next source row whose horizontal pass is needed
+    for (int y = 0; y < height; y++) {
+        for (int last = IM_MIN(y + ksize, height - 1); next_row <= last; next_row++) {
+            morph_unpack_row(bitmap, next_row, ksize, unpacked);
+            morph_hconvolve(unpacked, width, ksize, hkrn, rows + (next_row % n) * row_len);
+        }
+
+        const int32_t *src[n];
+        for (int j = 0; j < n; j++) {
+            src[j] = rows + (IM_MIN(IM_MAX(y + j - ksize, 0), height - 1) % n) * row_len;
+        }
+
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+        for (int x = 0; x < width; x++) {
+            if (mask && common_hal_displayio_bitmap_get_pixel(mask, x, y)) {
+                continue; // Short circuit.
+            }
+            int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+            for (int j = 0; j < n; j++) {
+                const int32_t *in = src[j] + 3 * x;
+                r_acc += vkrn[j] * in[0];
+                g_acc += vkrn[j] * in[1];
+                b_acc += vkrn[j] * in[2];
+            }
+            r_acc /= divisor;
+            g_acc /= divisor;
+            b_acc /= divisor;
+            int pixel = morph_finish_pixel(params, r_acc, g_acc, b_acc, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+            IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
+        }
+    }
+    return true;
+}
+
+// Box filter with running sums in both directions: cost per pixel is
+// constant regardless of ksize. The column sums are updated by adding the
+// row entering the window and subtracting the row leaving it, so output is
+// delayed by ksize+1 rows to keep the leaving row's original pixels intact.
+// Returns false, without touching the bitmap, if there isn't enough memory.
+static bool morph_box(displayio_bitmap_t *bitmap, displayio_bitmap_t *mask, int ksize,
+    int weight, const morph_params_t *params) {
+    int width = bitmap->width, height = bitmap->height;
+    int brows = ksize + 2;
+    size_t row_len = 3 * width;
+    int stride = (width + 1) / 2;
+
+    size_t buf_size = brows * stride * sizeof(uint32_t);
+    uint8_t *scratch = scratchpad_alloc_maybe(buf_size + (2 * row_len + 3 * (width + 2 * ksize)) * sizeof(int32_t));
+    if (!scratch) {
+        return false;
+    }
+    displayio_bitmap_t buf = {
+        .width = width,
+        .height = brows,
+        .stride = stride,
+        .data = (uint32_t *)scratch,
+    };
+    int32_t *col_sums = (int32_t *)(scratch + buf_size);
+    int32_t *row_sums = col_sums + row_len;
+    int32_t *unpacked = row_sums + row_len;
+
+    memset(col_sums, 0, row_len * sizeof(int32_t));
+    for (int j = -ksize; j <= ksize; j++) {
+        morph_unpack_row(bitmap, IM_MIN(IM_MAX(j, 0), height - 1), ksize, unpacked);
+        morph_hbox(unpacked, width, ksize, row_sums);
+        for (size_t i = 0; i < row_len; i++) {
+            col_sums[i] += row_sums[i];
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+        uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+        const int32_t *in = col_sums;
+        for (int x = 0; x < width; x++, in += 3) {
+            int orig_pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+            int pixel = orig_pixel;
+            if (!mask || !common_hal_displayio_bitmap_get_pixel(mask, x, y)) {
+                pixel = morph_finish_pixel(params, in[0] * weight, in[1] * weight, in[2] * weight, orig_pixel);
+            }
+            IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+        }
+
+        if (y + 1 < height) {
+            morph_unpack_row(bitmap, IM_MIN(y + ksize + 1, height - 1), ksize, unpacked);
+            morph_hbox(unpacked, width, ksize, row_sums);
+            for (size_t i = 0; i < row_len; i++) {
+                col_sums[i] += row_sums[i];
+            }
+            morph_unpack_row(bitmap, IM_MAX(y - ksize, 0), ksize, unpacked);
+            morph_hbox(unpacked, width, ksize, row_sums);
+            for (size_t i = 0; i < row_len; i++) {
+                col_sums[i] -= row_sums[i];
+            }
+        }
+
+        if (y >= ksize + 1) {     // Transfer buffer lines...
+            memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, (y - ksize - 1)),
+                IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize - 1) % brows)),
+                IMAGE_RGB565_LINE_LEN_BYTES(bitmap));
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(height - ksize - 1, 0); y < height; y++) {
+        memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y),
+            IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows)),
+            IMAGE_RGB565_LINE_LEN_BYTES(bitmap));
+    }
+    return true;
+}
+
 void shared_module_bitmapfilter_morph(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -101,13 +377,31 @@ void shared_module_bitmapfilter_morph(
 
     int brows = ksize + 1;
 
-    const int32_t m_int = (int32_t)MICROPY_FLOAT_C_FUN(round)(65536 * m);
-    const int32_t b_int = (int32_t)MICROPY_FLOAT_C_FUN(round)(65536 * COLOR_G6_MAX * b);
+    const morph_params_t params = {
+        .m_int = (int32_t)MICROPY_FLOAT_C_FUN(round)(65536 * m),
+        .b_int = (int32_t)MICROPY_FLOAT_C_FUN(round)(65536 * COLOR_G6_MAX * b),
+        .offset = offset,
+        .threshold = threshold,
+        .invert = invert,
+    };
 
     switch (bitmap->bits_per_value) {
         default:
             mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
         case 16: {
+            // Fast paths; these give exactly the same results as the general
+            // case, which needs less scratch memory and is used if they can't
+            // get enough.
+            if (morph_kernel_is_box(ksize, krn) && morph_box(bitmap, mask, ksize, krn[0], &params)) {
+                break;
+            }
+            int hkrn[2 * ksize + 1], vkrn[2 * ksize + 1];
+            int32_t divisor;
+            if (morph_kernel_separate(ksize, krn, hkrn, vkrn, &divisor) &&
+                morph_separable(bitmap, mask, ksize, hkrn, vkrn, divisor, &params)) {
+                break;
+            }
+
             displayio_bitmap_t buf;
             scratch_bitmap16(&buf, brows, bitmap->width);
 
@@ -146,35 +440,8 @@ void shared_module_bitmapfilter_morph(
                             }
                         }
                     }
-                    r_acc = (r_acc * m_int + b_int) >> 16;
-                    if (r_acc > COLOR_R5_MAX) {
-                        r_acc = COLOR_R5_MAX;
-                    } else if (r_acc < 0) {
-                        r_acc = 0;
-                    }
-                    g_acc = (g_acc * m_int + b_int * 2) >> 16;
-                    if (g_acc > COLOR_G6_MAX) {
-                        g_acc = COLOR_G6_MAX;
-                    } else if (g_acc < 0) {
-                        g_acc = 0;
-                    }
-                    b_acc = (b_acc * m_int + b_int) >> 16;
-                    if (b_acc > COLOR_B5_MAX) {
-                        b_acc = COLOR_B5_MAX;
-                    } else if (b_acc < 0) {
-                        b_acc = 0;
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
-
-                    if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
-                    }
 
+                    int pixel = morph_finish_pixel(&params, r_acc, g_acc, b_acc, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
@@ -424,3 +691,115 @@ void shared_module_bitmapfilter_blend(
         }
     }
 }
+
+static void channel_statistics_finish(bitmapfilter_channel_statistics_t *stats, size_t count) {
+    stats->mean = stats->stddev = 0;
+    stats->min = stats->max = 0;
+    if (!count) {
+        return;
+    }
+    uint64_t sum = 0, sum_sq = 0;
+    int min = -1, max = 0;
+    for (size_t i = 0; i < stats->bins; i++) {
+        uint32_t n = stats->histogram[i];
+        if (!n) {
+            continue;
+        }
+        if (min < 0) {
+            min = i;
+        }
+        max = i;
+        sum += (uint64_t)n * i;
+        sum_sq += (uint64_t)n * i * i;
+    }
+    mp_float_t mean = (mp_float_t)sum / count;
+    mp_float_t variance = (mp_float_t)sum_sq / count - mean * mean;
+    stats->mean = mean;
+    stats->stddev = variance > 0 ? MICROPY_FLOAT_C_FUN(sqrt)(variance) : 0;
+    stats->min = min;
+    stats->max = max;
+}
+
+size_t shared_module_bitmapfilter_statistics(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    bitmapfilter_channel_statistics_t stats[3],
+    uint32_t *integral) {
+
+    int width = bitmap->width, height = bitmap->height;
+    size_t count = 0;
+    int nchannels = bitmap->bits_per_value == 16 ? 3 : 1;
+    for (int i = 0; i < nchannels; i++) {
+        memset(stats[i].histogram, 0, stats[i].bins * sizeof(uint32_t));
+    }
+
+    // The summed-area table has an extra all-zero row and column so that
+    // region sums need no special case at the top and left edges. Each row
+    // is the previous row plus a running sum along the current one, so it is
+    // filled in the same pass as the histograms.
+    uint32_t *integral_row = NULL;
+    if (integral) {
+        memset(integral, 0, (width + 1) * sizeof(uint32_t));
+        integral_row = integral + width + 1;
+    }
+
+    switch (bitmap->bits_per_value) {
+        default:
+            mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
+        case 16: {
+            uint32_t *hist_r = stats[0].histogram, *hist_g = stats[1].histogram, *hist_b = stats[2].histogram;
+            for (int y = 0; y < height; y++) {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+                uint32_t row_sum = 0;
+                for (int x = 0; x < width; x++) {
+                    if (!(mask && common_hal_displayio_bitmap_get_pixel(mask, x, y))) {
+                        int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                        hist_r[COLOR_RGB565_TO_R5(pixel)]++;
+                        hist_g[COLOR_RGB565_TO_G6(pixel)]++;
+                        hist_b[COLOR_RGB565_TO_B5(pixel)]++;
+                        count++;
+                        if (integral_row) {
+                            row_sum += COLOR_RGB565_TO_Y(pixel);
+                        }
+                    }
+                    if (integral_row) {
+                        integral_row[x + 1] = integral_row[x + 1 - (width + 1)] + row_sum;
+                    }
+                }
+                if (integral_row) {
+                    integral_row[0] = 0;
+                    integral_row += width + 1;
+                }
+            }
+            break;
+        }
+        case 8: {
+            uint32_t *hist = stats[0].histogram;
+            for (int y = 0; y < height; y++) {
+                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(bitmap, y);
+                uint32_t row_sum = 0;
+                for (int x = 0; x < width; x++) {
+                    if (!(mask && common_hal_displayio_bitmap_get_pixel(mask, x, y))) {
+                        int pixel = row_ptr[x];
+                        hist[pixel]++;
+                        count++;
+                        row_sum += pixel;
+                    }
+                    if (integral_row) {
+                        integral_row[x + 1] = integral_row[x + 1 - (width + 1)] + row_sum;
+                    }
+                }
+                if (integral_row) {
+                    integral_row[0] = 0;
+                    integral_row += width + 1;
+                }
+            }
+            break;
+        }
+    }
+
+    for (int i = 0; i < nchannels; i++) {
+        channel_statistics_finish(&stats[i], count);
+    }
+    return count;
+}
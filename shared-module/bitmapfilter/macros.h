@@ -26,6 +26,8 @@
     __builtin_bswap16((rowptr)[(x)])
 #define IMAGE_PUT_RGB565_PIXEL_FAST(rowptr, x, val) \
     ((rowptr)[(x)] = __builtin_bswap16((val)))
+#define IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(bitmap, y) \
+    (uint8_t *)(&(bitmap)->data[(bitmap)->stride * (y)])
 #define COLOR_R5_G6_B5_TO_RGB565(r, g, b) \
     (((r) << 11) | ((g) << 5) | (b))
 #define COLOR_R8_G8_B8_TO_RGB565(r8, g8, b8)    ((((r8) & 0xF8) << 8) | (((g8) & 0xFC) << 3) | ((b8) >> 3))
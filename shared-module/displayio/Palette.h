@@ -39,7 +39,7 @@ typedef struct {
     uint32_t pixel;
     uint16_t x;
     uint16_t y;
-    uint8_t tile;
+    uint16_t tile;
     uint16_t tile_x;
     uint16_t tile_y;
 } displayio_input_pixel_t;
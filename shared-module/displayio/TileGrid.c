@@ -6,6 +6,8 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
@@ -15,26 +17,55 @@
 #include "shared-bindings/tilepalettemapper/TilePaletteMapper.h"
 #endif
 
+// Tiles are stored as uint16_t when wide_tiles is set and as uint8_t otherwise.
+static void *tilegrid_tiles(displayio_tilegrid_t *self) {
+    if (self->inline_tiles) {
+        return &self->tiles;
+    }
+    return self->tiles;
+}
+
+static size_t tilegrid_tile_size(displayio_tilegrid_t *self) {
+    return self->wide_tiles ? sizeof(uint16_t) : sizeof(uint8_t);
+}
+
+static uint16_t tilegrid_load_tile(displayio_tilegrid_t *self, const void *tiles, size_t i) {
+    if (self->wide_tiles) {
+        return ((const uint16_t *)tiles)[i];
+    }
+    return ((const uint8_t *)tiles)[i];
+}
+
+static void tilegrid_store_tile(displayio_tilegrid_t *self, void *tiles, size_t i, uint16_t tile_index) {
+    if (self->wide_tiles) {
+        ((uint16_t *)tiles)[i] = tile_index;
+    } else {
+        ((uint8_t *)tiles)[i] = tile_index;
+    }
+}
+
 void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_t bitmap,
     uint16_t bitmap_width_in_tiles, uint16_t bitmap_height_in_tiles,
     mp_obj_t pixel_shader, uint16_t width, uint16_t height,
-    uint16_t tile_width, uint16_t tile_height, uint16_t x, uint16_t y, uint8_t default_tile) {
+    uint16_t tile_width, uint16_t tile_height, uint16_t x, uint16_t y, uint16_t default_tile) {
     uint32_t total_tiles = width * height;
+    // Tile values are single bytes unless the bitmap has more tiles than a byte can index.
+    self->wide_tiles = bitmap_width_in_tiles * bitmap_height_in_tiles > 256;
     // Sprites will only have one tile so save a little memory by inlining values in the pointer.
-    uint8_t inline_tiles = sizeof(uint8_t *);
+    uint8_t inline_tiles = sizeof(uint8_t *) / tilegrid_tile_size(self);
     if (total_tiles <= inline_tiles) {
         self->tiles = 0;
+        self->inline_tiles = true;
         // Pack values into the pointer since there are only a few.
         for (uint32_t i = 0; i < inline_tiles; i++) {
-            ((uint8_t *)&self->tiles)[i] = default_tile;
+            tilegrid_store_tile(self, &self->tiles, i, default_tile);
         }
-        self->inline_tiles = true;
     } else {
-        self->tiles = (uint8_t *)m_malloc(total_tiles);
+        self->tiles = (uint8_t *)m_malloc(total_tiles * tilegrid_tile_size(self));
+        self->inline_tiles = false;
         for (uint32_t i = 0; i < total_tiles; i++) {
-            self->tiles[i] = default_tile;
+            tilegrid_store_tile(self, self->tiles, i, default_tile);
         }
-        self->inline_tiles = false;
     }
     self->bitmap_width_in_tiles = bitmap_width_in_tiles;
     self->tiles_in_bitmap = bitmap_width_in_tiles * bitmap_height_in_tiles;
@@ -234,29 +265,16 @@ uint16_t common_hal_displayio_tilegrid_get_tile_height(displayio_tilegrid_t *sel
     return self->tile_height;
 }
 
-uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
-    uint8_t *tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t *)&self->tiles;
-    }
+uint16_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+    void *tiles = tilegrid_tiles(self);
     if (tiles == NULL) {
         return 0;
     }
-    return tiles[y * self->width_in_tiles + x];
+    return tilegrid_load_tile(self, tiles, y * self->width_in_tiles + x);
 }
 
-void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
-    if (tile_index >= self->tiles_in_bitmap) {
-        mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
-    }
-    uint8_t *tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t *)&self->tiles;
-    }
-    if (tiles == NULL) {
-        return;
-    }
-    tiles[y * self->width_in_tiles + x] = tile_index;
+// Add count tiles in row y, starting at column x, to the dirty area.
+static void tilegrid_mark_tiles_dirty(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t count) {
     displayio_area_t temp_area;
     displayio_area_t *tile_area;
     if (!self->partial_change) {
@@ -268,8 +286,13 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     if (tx < 0) {
         tx += self->width_in_tiles;
     }
+    if (tx + count > self->width_in_tiles) {
+        // The tiles wrap around the right edge so mark the whole row.
+        tx = 0;
+        count = self->width_in_tiles;
+    }
     tile_area->x1 = tx * self->tile_width;
-    tile_area->x2 = tile_area->x1 + self->tile_width;
+    tile_area->x2 = tile_area->x1 + count * self->tile_width;
     int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
     if (ty < 0) {
         ty += self->height_in_tiles;
@@ -284,22 +307,80 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     self->partial_change = true;
 }
 
-void common_hal_displayio_tilegrid_set_all_tiles(displayio_tilegrid_t *self, uint8_t tile_index) {
+void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t tile_index) {
     if (tile_index >= self->tiles_in_bitmap) {
         mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
     }
-    uint8_t *tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t *)&self->tiles;
+    void *tiles = tilegrid_tiles(self);
+    if (tiles == NULL) {
+        return;
+    }
+    tilegrid_store_tile(self, tiles, y * self->width_in_tiles + x, tile_index);
+    tilegrid_mark_tiles_dirty(self, x, y, 1);
+}
+
+void displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint16_t *tile_indices, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (tile_indices[i] >= self->tiles_in_bitmap) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
+        }
+    }
+    void *tiles = tilegrid_tiles(self);
+    if (tiles == NULL || count == 0) {
+        return;
+    }
+    size_t start = y * self->width_in_tiles + x;
+    for (uint16_t i = 0; i < count; i++) {
+        tilegrid_store_tile(self, tiles, start + i, tile_indices[i]);
+    }
+    tilegrid_mark_tiles_dirty(self, x, y, count);
+}
+
+void displayio_tilegrid_fill_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t tile_index, uint16_t count) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
+    }
+    void *tiles = tilegrid_tiles(self);
+    if (tiles == NULL || count == 0) {
+        return;
     }
+    size_t start = y * self->width_in_tiles + x;
+    if (self->wide_tiles) {
+        for (uint16_t i = 0; i < count; i++) {
+            ((uint16_t *)tiles)[start + i] = tile_index;
+        }
+    } else {
+        memset((uint8_t *)tiles + start, tile_index, count);
+    }
+    tilegrid_mark_tiles_dirty(self, x, y, count);
+}
+
+void displayio_tilegrid_copy_row(displayio_tilegrid_t *self, uint16_t from_y, uint16_t to_y) {
+    uint8_t *tiles = tilegrid_tiles(self);
+    if (tiles == NULL || from_y == to_y) {
+        return;
+    }
+    size_t row_size = self->width_in_tiles * tilegrid_tile_size(self);
+    memcpy(tiles + to_y * row_size, tiles + from_y * row_size, row_size);
+    tilegrid_mark_tiles_dirty(self, 0, to_y, self->width_in_tiles);
+}
+
+void common_hal_displayio_tilegrid_set_all_tiles(displayio_tilegrid_t *self, uint16_t tile_index) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
+    }
+    void *tiles = tilegrid_tiles(self);
     if (tiles == NULL) {
         return;
     }
 
-    for (uint16_t x = 0; x < self->width_in_tiles; x++) {
-        for (uint16_t y = 0; y < self->height_in_tiles; y++) {
-            tiles[y * self->width_in_tiles + x] = tile_index;
+    size_t total_tiles = self->width_in_tiles * self->height_in_tiles;
+    if (self->wide_tiles) {
+        for (size_t i = 0; i < total_tiles; i++) {
+            ((uint16_t *)tiles)[i] = tile_index;
         }
+    } else {
+        memset(tiles, tile_index, total_tiles);
     }
 
     self->full_change = true;
@@ -368,10 +449,7 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
     uint32_t *mask, uint32_t *buffer) {
     // If no tiles are present we have no impact.
-    uint8_t *tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t *)&self->tiles;
-    }
+    void *tiles = tilegrid_tiles(self);
     if (tiles == NULL) {
         return false;
     }
@@ -474,7 +552,7 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
             uint16_t x_tile_index = (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
             uint16_t y_tile_index = (local_y / self->tile_height + self->top_left_y) % self->height_in_tiles;
             uint16_t tile_location = y_tile_index * self->width_in_tiles + x_tile_index;
-            input_pixel.tile = tiles[tile_location];
+            input_pixel.tile = tilegrid_load_tile(self, tiles, tile_location);
             input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
             input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
 
@@ -46,11 +46,19 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool rendered_hidden : 1;
-    uint8_t padding : 6;
+    bool wide_tiles : 1; // Tiles are uint16_t instead of uint8_t.
+    uint8_t padding : 5;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
 
+// Set count tiles in row y starting at column x with one dirty area update. x + count must not
+// exceed the width in tiles. Used by terminalio to write runs of text.
+void displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint16_t *tile_indices, uint16_t count);
+void displayio_tilegrid_fill_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t tile_index, uint16_t count);
+// Copy every tile in row from_y to row to_y.
+void displayio_tilegrid_copy_row(displayio_tilegrid_t *self, uint16_t from_y, uint16_t to_y);
+
 // Updating the screen is a three stage process.
 
 // The first stage is used to determine i
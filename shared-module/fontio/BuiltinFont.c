@@ -22,27 +22,30 @@ mp_obj_t common_hal_fontio_builtinfont_get_bounding_box(const fontio_builtinfont
     return mp_obj_new_tuple(2, items);
 }
 
-uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
+uint16_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
     if (codepoint >= 0x20 && codepoint <= 0x7e) {
         return codepoint - 0x20;
     }
-    // Do a linear search of the mapping for unicode.
-    const byte *j = self->unicode_characters;
-    uint8_t k = 0;
-    while (j < self->unicode_characters + self->unicode_characters_len) {
-        unichar potential_c = utf8_get_char(j);
-        j = utf8_next_char(j);
+    // Binary search the sorted codepoints of the rest of the glyphs.
+    size_t lo = 0;
+    size_t hi = self->unicode_codepoints_len;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        mp_uint_t potential_c = self->unicode_codepoints[mid];
         if (codepoint == potential_c) {
-            return 0x7f - 0x20 + k;
+            return 0x7f - 0x20 + mid;
+        } else if (codepoint < potential_c) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
         }
-        k++;
     }
-    return 0xff;
+    return FONTIO_BUILTINFONT_NO_GLYPH;
 }
 
 mp_obj_t common_hal_fontio_builtinfont_get_glyph(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
-    uint8_t glyph_index = fontio_builtinfont_get_glyph_index(self, codepoint);
-    if (glyph_index == 0xff) {
+    uint16_t glyph_index = fontio_builtinfont_get_glyph_index(self, codepoint);
+    if (glyph_index == FONTIO_BUILTINFONT_NO_GLYPH) {
         return mp_const_none;
     }
     mp_obj_t field_values[8] = {
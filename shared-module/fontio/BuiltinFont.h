@@ -17,8 +17,12 @@ typedef struct {
     const displayio_bitmap_t *bitmap;
     uint8_t width;
     uint8_t height;
-    const byte *unicode_characters;
-    uint16_t unicode_characters_len;
+    // Codepoints of the glyphs after the printable ASCII ones, in ascending order.
+    const uint16_t *unicode_codepoints;
+    uint16_t unicode_codepoints_len;
 } fontio_builtinfont_t;
 
-uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint);
+// Returned by fontio_builtinfont_get_glyph_index() when the font has no glyph for a codepoint.
+#define FONTIO_BUILTINFONT_NO_GLYPH (0xffff)
+
+uint16_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint);
@@ -16,7 +16,30 @@
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/util.h"
 
-#define BLOCK_SIZE (126) // (2^7) - 2 // (DO NOT CHANGE!)
+// The output buffer only has to hold the file header; image data is streamed
+// through it in sub-blocks and flushed to the file whenever it fills up.
+#define OUTPUT_BUFFER_SIZE (2048)
+
+// The global color table has 256 entries. Only the first 128 are real colors;
+// this one is used as the transparent color for pixels that did not change.
+#define TRANSPARENT_INDEX (0x80)
+// While a delta frame is written, prev_frame holds the new frame's indices
+// with this bit set on the pixels that changed.
+#define CHANGED_FLAG (0x80)
+
+#define LZW_MIN_CODE_SIZE (8)
+#define LZW_CLEAR_CODE (1 << LZW_MIN_CODE_SIZE)
+#define LZW_EOI_CODE (LZW_CLEAR_CODE + 1)
+#define LZW_FIRST_CODE (LZW_CLEAR_CODE + 2)
+#define LZW_HASH_BITS (12)
+#define LZW_HASH_SIZE (1 << LZW_HASH_BITS)
+// The dictionary is cleared once the hash table is 3/4 full, which keeps
+// probe sequences short. This is below the GIF limit of 4096 codes.
+#define LZW_MAX_CODE (LZW_HASH_SIZE * 3 / 4)
+// Each hash table entry packs the code in the upper bits and the key, a
+// (prefix code, pixel) pair, in the lower 20 bits. Zero is an empty slot.
+#define LZW_KEY_BITS (20)
+#define LZW_KEY_MASK ((1 << LZW_KEY_BITS) - 1)
 
 static void handle_error(gifio_gifwriter_t *self) {
     if (self->error != 0) {
@@ -36,8 +59,15 @@ static void flush_data(gifio_gifwriter_t *self) {
     }
 }
 
+static void ensure_space(gifio_gifwriter_t *self, size_t size) {
+    if (self->cur + size > self->size) {
+        flush_data(self);
+    }
+}
+
 // These "write" calls _MUST_ have enough buffer space available!  This is
-// ensured by allocating the proper buffer size in construct.
+// ensured by allocating the proper buffer size in construct, or by calling
+// ensure_space first.
 static void write_data(gifio_gifwriter_t *self, const void *data, size_t size) {
     assert(self->cur + size <= self->size);
     memcpy(self->data + self->cur, data, size);
@@ -48,10 +78,6 @@ static void write_byte(gifio_gifwriter_t *self, uint8_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_long(gifio_gifwriter_t *self, uint32_t value) {
-    write_data(self, &value, sizeof(value));
-}
-
 static void write_word(gifio_gifwriter_t *self, uint16_t value) {
     write_data(self, &value, sizeof(value));
 }
@@ -68,16 +94,19 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
     self->dither = dither;
     self->own_file = own_file;
 
-    size_t nblocks = (width * height + 125) / 126;
-    self->size = nblocks * 128 + 4;
+    self->size = OUTPUT_BUFFER_SIZE;
     self->data = m_malloc(self->size);
     self->cur = 0;
     self->error = 0;
+    self->prev_frame = m_malloc(width * height);
+    self->row = m_malloc(width);
+    self->lzw_table = m_malloc(LZW_HASH_SIZE * sizeof(uint32_t));
+    self->have_prev_frame = false;
 
     write_data(self, "GIF89a", 6);
     write_word(self, width);
     write_word(self, height);
-    write_data(self, (uint8_t []) {0xF6, 0x00, 0x00}, 3);
+    write_data(self, (uint8_t []) {0xF7, 0x00, 0x00}, 3);
 
     switch (colorspace) {
         case DISPLAYIO_COLORSPACE_RGB565:
@@ -113,6 +142,10 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
             write_data(self, (uint8_t []) {gray, gray, gray}, 3);
         }
     }
+    // Pad the table out to 256 entries, so that TRANSPARENT_INDEX exists
+    for (int i = 128; i < 256; i++) {
+        write_data(self, (uint8_t []) {0, 0, 0}, 3);
+    }
 
     if (loop) {
         write_data(self, (uint8_t []) {'!', 0xFF, 0x0B}, 3);
@@ -154,96 +187,232 @@ static const uint8_t g_bayer[4][4] = {
     {31, 14, 26, 10}
 };
 
-void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
-    if (delay) {
-        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
-        write_word(self, delay);
-        write_word(self, 0); // end
+typedef struct {
+    gifio_gifwriter_t *writer;
+    uint32_t *table;
+    uint32_t bits;
+    int nbits;
+    int code_size;
+    int next_code;
+    int prefix;
+    uint8_t block_len;
+    uint8_t block[255];
+} lzw_encoder_t;
+
+static void lzw_flush_block(lzw_encoder_t *enc) {
+    if (enc->block_len == 0) {
+        return;
     }
+    gifio_gifwriter_t *self = enc->writer;
+    ensure_space(self, 1 + enc->block_len);
+    write_byte(self, enc->block_len);
+    write_data(self, enc->block, enc->block_len);
+    enc->block_len = 0;
+}
 
-    write_byte(self, 0x2C);
-    write_long(self, 0);
-    write_word(self, self->width);
-    write_word(self, self->height);
-    write_data(self, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
+static void lzw_put_code(lzw_encoder_t *enc, int code) {
+    enc->bits |= (uint32_t)code << enc->nbits;
+    enc->nbits += enc->code_size;
+    while (enc->nbits >= 8) {
+        enc->block[enc->block_len++] = enc->bits & 0xff;
+        enc->bits >>= 8;
+        enc->nbits -= 8;
+        if (enc->block_len == sizeof(enc->block)) {
+            lzw_flush_block(enc);
+        }
+    }
+}
+
+static void lzw_reset(lzw_encoder_t *enc) {
+    memset(enc->table, 0, LZW_HASH_SIZE * sizeof(uint32_t));
+    enc->code_size = LZW_MIN_CODE_SIZE + 1;
+    enc->next_code = LZW_FIRST_CODE;
+}
+
+static void lzw_begin(lzw_encoder_t *enc, gifio_gifwriter_t *self) {
+    enc->writer = self;
+    enc->table = self->lzw_table;
+    enc->bits = 0;
+    enc->nbits = 0;
+    enc->block_len = 0;
+    enc->prefix = -1;
+    ensure_space(self, 1);
+    write_byte(self, LZW_MIN_CODE_SIZE);
+    lzw_reset(enc);
+    lzw_put_code(enc, LZW_CLEAR_CODE);
+}
+
+static void lzw_add(lzw_encoder_t *enc, uint8_t pixel) {
+    if (enc->prefix < 0) {
+        enc->prefix = pixel;
+        return;
+    }
+    uint32_t key = ((uint32_t)enc->prefix << 8) | pixel;
+    uint32_t idx = (key * 2654435761u) >> (32 - LZW_HASH_BITS);
+    while (enc->table[idx]) {
+        uint32_t entry = enc->table[idx];
+        if ((entry & LZW_KEY_MASK) == key) {
+            enc->prefix = entry >> LZW_KEY_BITS;
+            return;
+        }
+        idx = (idx + 1) & (LZW_HASH_SIZE - 1);
+    }
+
+    lzw_put_code(enc, enc->prefix);
+    if (enc->next_code < LZW_MAX_CODE) {
+        // The decoder widens its codes as soon as its table size reaches a
+        // power of two, which happens one code after ours does.
+        if (enc->next_code == (1 << enc->code_size)) {
+            enc->code_size++;
+        }
+        enc->table[idx] = ((uint32_t)enc->next_code++ << LZW_KEY_BITS) | key;
+    } else {
+        lzw_put_code(enc, LZW_CLEAR_CODE);
+        lzw_reset(enc);
+    }
+    enc->prefix = pixel;
+}
 
-    int pixel_count = self->width * self->height;
-    int blocks = (pixel_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+static void lzw_end(lzw_encoder_t *enc) {
+    if (enc->prefix >= 0) {
+        lzw_put_code(enc, enc->prefix);
+        // The decoder adds a table entry for this final code too
+        if (enc->next_code == (1 << enc->code_size)) {
+            enc->code_size++;
+        }
+    }
+    lzw_put_code(enc, LZW_EOI_CODE);
+    if (enc->nbits > 0) {
+        enc->block[enc->block_len++] = enc->bits & 0xff;
+    }
+    lzw_flush_block(enc);
+    ensure_space(enc->writer, 1);
+    write_byte(enc->writer, 0); // block terminator
+}
 
-    uint8_t *data = self->data + self->cur;
+// Convert one row of the frame into palette indices in self->row
+static void quantize_row(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int y) {
+    uint8_t *out = self->row;
+    int width = self->width;
 
     if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(pixel_count - 1), false);
-
-        uint8_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            assert(pixel_count >= 0);
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                *data++ = (*pixels++) >> 1;
-            }
+        const uint8_t *pixels = (const uint8_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            *out++ = (*pixels++) >> 1;
         }
     } else if (!self->dither) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> (11 + (5 - 2))) & 0x3;
-                int green = (pixel >> (5 + (6 - 3))) & 0x7;
-                int blue = (pixel >> (0 + (5 - 2))) & 0x3;
-                *data++ = (red << 5) | (green << 2) | blue;
+        const uint16_t *pixels = (const uint16_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = *pixels++;
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
             }
+            int red = (pixel >> (11 + (5 - 2))) & 0x3;
+            int green = (pixel >> (5 + (6 - 3))) & 0x7;
+            int blue = (pixel >> (0 + (5 - 2))) & 0x3;
+            *out++ = (red << 5) | (green << 2) | blue;
         }
     } else {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        int x = 0, y = 0;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> 8) & 0xf8;
-                int green = (pixel >> 3) & 0xfc;
-                int blue = (pixel << 3) & 0xf8;
-
-                red = MAX(0, red - rb_bayer[x % 4][y % 4]);
-                green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
-                blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
-                x++;
-                if (x == self->width) {
-                    x = 0;
-                    y++;
-                }
+        const uint16_t *pixels = (const uint16_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = *pixels++;
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
+            }
+            int red = (pixel >> 8) & 0xf8;
+            int green = (pixel >> 3) & 0xfc;
+            int blue = (pixel << 3) & 0xf8;
+
+            red = MAX(0, red - rb_bayer[x % 4][y % 4]);
+            green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
+            blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
+
+            *out++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+        }
+    }
+}
 
-                *data++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
+    int width = self->width;
+    int pixel_count = width * self->height;
+    int bytes_per_pixel = (self->colorspace == DISPLAYIO_COLORSPACE_L8) ? 1 : 2;
+    mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(bytes_per_pixel * pixel_count - 1), false);
+
+    // After the first frame, only the bounding box of the pixels that changed
+    // is written, and unchanged pixels inside it are transparent. Long runs of
+    // transparent pixels compress very well.
+    bool delta = self->have_prev_frame;
+    int x0 = 0, y0 = 0, x1 = width - 1, y1 = self->height - 1;
+    if (delta) {
+        x0 = width;
+        y0 = self->height;
+        x1 = y1 = -1;
+        for (int y = 0; y < self->height; y++) {
+            quantize_row(self, bufinfo, y);
+            uint8_t *prev = self->prev_frame + y * width;
+            if (memcmp(self->row, prev, width) == 0) {
+                continue;
+            }
+            int left = width, right = 0;
+            for (int x = 0; x < width; x++) {
+                if (self->row[x] != prev[x]) {
+                    prev[x] = self->row[x] | CHANGED_FLAG;
+                    left = MIN(left, x);
+                    right = x;
+                }
             }
+            x0 = MIN(x0, left);
+            x1 = MAX(x1, right);
+            y0 = MIN(y0, y);
+            y1 = y;
         }
+        if (y1 < 0) {
+            // Nothing changed, but the frame is still needed for its delay
+            x0 = y0 = x1 = y1 = 0;
+        }
+    }
+
+    ensure_space(self, 8 + 10);
+    if (delay || delta) {
+        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, delta ? 0x05 : 0x04}, 4);
+        write_word(self, delay);
+        write_byte(self, delta ? TRANSPARENT_INDEX : 0);
+        write_byte(self, 0); // end
     }
 
-    self->cur = data - self->data;
+    write_byte(self, 0x2C);
+    write_word(self, x0);
+    write_word(self, y0);
+    write_word(self, x1 - x0 + 1);
+    write_word(self, y1 - y0 + 1);
+    write_byte(self, 0x00);
+
+    lzw_encoder_t enc;
+    lzw_begin(&enc, self);
+    for (int y = y0; y <= y1; y++) {
+        uint8_t *prev = self->prev_frame + y * width;
+        if (delta) {
+            // The rows were already quantized into prev_frame above
+            for (int x = x0; x <= x1; x++) {
+                uint8_t pixel = prev[x];
+                if (pixel & CHANGED_FLAG) {
+                    prev[x] = pixel & ~CHANGED_FLAG;
+                    lzw_add(&enc, prev[x]);
+                } else {
+                    lzw_add(&enc, TRANSPARENT_INDEX);
+                }
+            }
+        } else {
+            quantize_row(self, bufinfo, y);
+            memcpy(prev, self->row, width);
+            for (int x = x0; x <= x1; x++) {
+                lzw_add(&enc, self->row[x]);
+            }
+        }
+    }
+    lzw_end(&enc);
 
-    write_data(self, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
+    self->have_prev_frame = true;
     flush_data(self);
     handle_error(self);
 }
@@ -255,6 +424,14 @@ void shared_module_gifio_gifwriter_close(gifio_gifwriter_t *self) {
     int error = 0;
     self->file_proto->ioctl(self->file, self->own_file ? MP_STREAM_CLOSE : MP_STREAM_FLUSH, 0, &error);
     self->file = NULL;
+    m_del(uint8_t, self->data, self->size);
+    self->data = NULL;
+    m_del(uint8_t, self->prev_frame, self->width * self->height);
+    self->prev_frame = NULL;
+    m_del(uint8_t, self->row, self->width);
+    self->row = NULL;
+    m_del(uint32_t, self->lzw_table, LZW_HASH_SIZE);
+    self->lzw_table = NULL;
 
     if (error != 0) {
         self->error = error;
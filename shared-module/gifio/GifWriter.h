@@ -19,7 +19,11 @@ typedef struct gifio_gifwriter {
     int error;
     uint8_t *data;
     size_t cur, size;
+    uint8_t *prev_frame; // palette indices of the previously written frame
+    uint8_t *row; // one row of palette indices for the frame being written
+    uint32_t *lzw_table; // open-addressed hash of (prefix, suffix) -> code
     bool own_file;
     bool byteswap;
     bool dither;
+    bool have_prev_frame;
 } gifio_gifwriter_t;
@@ -127,7 +127,7 @@ static void GIFDraw(GIFDRAW *pDraw) {
     }
 }
 
-void common_hal_gifio_ondiskgif_construct(gifio_ondiskgif_t *self, pyb_file_obj_t *file, bool use_palette) {
+void common_hal_gifio_ondiskgif_construct(gifio_ondiskgif_t *self, pyb_file_obj_t *file, bool use_palette, int32_t keyframe_interval) {
     self->file = file;
 
     if (use_palette == true) {
@@ -179,9 +179,85 @@ void common_hal_gifio_ondiskgif_construct(gifio_ondiskgif_t *self, pyb_file_obj_
     self->frame_count = info.iFrameCount;
     self->min_delay = info.iMinDelay;
     self->max_delay = info.iMaxDelay;
+
+    // GIF_getInfo leaves the file positioned wherever its scan ended
+    GIF_reset(&self->gif);
+    self->frame = 0;
+    self->frames_indexed = 0;
+    self->frame_offsets = m_malloc(MAX(self->frame_count, 1) * sizeof(int32_t));
+    self->keyframe_interval = keyframe_interval;
+    self->keyframes = NULL;
+    if (keyframe_interval > 0) {
+        size_t n_keyframes = (self->frame_count + keyframe_interval - 1) / keyframe_interval;
+        self->keyframes = m_malloc0(MAX(n_keyframes, 1) * sizeof(uint32_t *));
+    }
+}
+
+static size_t bitmap_data_size(displayio_bitmap_t *bitmap) {
+    return bitmap->stride * bitmap->height * sizeof(uint32_t);
+}
+
+// Frames can carry their own palette, so a keyframe stores the palette after
+// the bitmap contents, one word per color with KEYFRAME_TRANSPARENT set for
+// transparent entries.
+#define KEYFRAME_TRANSPARENT (1u << 31)
+
+static size_t keyframe_size(gifio_ondiskgif_t *self) {
+    size_t size = bitmap_data_size(self->bitmap);
+    if (self->palette != NULL) {
+        size += common_hal_displayio_palette_get_len(self->palette) * sizeof(uint32_t);
+    }
+    return size;
+}
+
+static void save_keyframe(gifio_ondiskgif_t *self, uint32_t *keyframe) {
+    size_t size = bitmap_data_size(self->bitmap);
+    memcpy(keyframe, self->bitmap->data, size);
+    if (self->palette != NULL) {
+        uint32_t *colors = keyframe + size / sizeof(uint32_t);
+        for (uint32_t i = 0; i < common_hal_displayio_palette_get_len(self->palette); i++) {
+            colors[i] = common_hal_displayio_palette_get_color(self->palette, i);
+            if (common_hal_displayio_palette_is_transparent(self->palette, i)) {
+                colors[i] |= KEYFRAME_TRANSPARENT;
+            }
+        }
+    }
+}
+
+static void restore_keyframe(gifio_ondiskgif_t *self, const uint32_t *keyframe) {
+    size_t size = bitmap_data_size(self->bitmap);
+    memcpy(self->bitmap->data, keyframe, size);
+    if (self->palette != NULL) {
+        const uint32_t *colors = keyframe + size / sizeof(uint32_t);
+        for (uint32_t i = 0; i < common_hal_displayio_palette_get_len(self->palette); i++) {
+            common_hal_displayio_palette_set_color(self->palette, i, colors[i] & ~KEYFRAME_TRANSPARENT);
+            if (colors[i] & KEYFRAME_TRANSPARENT) {
+                common_hal_displayio_palette_make_transparent(self->palette, i);
+            } else {
+                common_hal_displayio_palette_make_opaque(self->palette, i);
+            }
+        }
+    }
 }
 
 void common_hal_gifio_ondiskgif_deinit(gifio_ondiskgif_t *self) {
+    if (common_hal_gifio_ondiskgif_deinited(self)) {
+        return;
+    }
+    if (self->keyframes != NULL) {
+        size_t n_keyframes = (self->frame_count + self->keyframe_interval - 1) / self->keyframe_interval;
+        n_keyframes = MAX(n_keyframes, 1);
+        size_t size = keyframe_size(self);
+        for (size_t k = 0; k < n_keyframes; k++) {
+            if (self->keyframes[k] != NULL) {
+                m_del(uint8_t, self->keyframes[k], size);
+            }
+        }
+        m_del(uint32_t *, self->keyframes, n_keyframes);
+        self->keyframes = NULL;
+    }
+    m_del(int32_t, self->frame_offsets, MAX(self->frame_count, 1));
+    self->frame_offsets = NULL;
     self->file = NULL;
     common_hal_displayio_bitmap_deinit(self->bitmap);
     self->bitmap = NULL;
@@ -230,18 +306,83 @@ int32_t common_hal_gifio_ondiskgif_get_max_delay(gifio_ondiskgif_t *self) {
 uint32_t common_hal_gifio_ondiskgif_next_frame(gifio_ondiskgif_t *self, bool setDirty) {
     int nextDelay = 0;
     int result = 0;
+
+    // GIF_playFrame starts over from the first frame once it reaches the end of the file
+    if (self->gif.GIFFile.iPos >= self->gif.GIFFile.iSize - 1) {
+        self->frame = 0;
+    }
+    int32_t frame = self->frame;
+    if (frame < self->frame_count) {
+        if (frame == self->frames_indexed) {
+            self->frame_offsets[frame] = self->gif.GIFFile.iPos;
+            self->frames_indexed++;
+        }
+        if (self->keyframes && frame > 0 && frame % self->keyframe_interval == 0) {
+            uint32_t **keyframe = &self->keyframes[frame / self->keyframe_interval];
+            if (*keyframe == NULL) {
+                *keyframe = m_malloc(keyframe_size(self));
+                save_keyframe(self, *keyframe);
+            }
+        }
+    }
+
     result = GIF_playFrame(&self->gif, &nextDelay, self);
+    self->frame = frame + 1;
 
     if ((result >= 0) && (setDirty)) {
+        // Only the area covered by this frame can have changed
         displayio_area_t dirty_area = {
-            .x1 = 0,
-            .y1 = 0,
-            .x2 = self->bitmap->width,
-            .y2 = self->bitmap->height,
+            .x1 = MAX(0, self->gif.iX),
+            .y1 = MAX(0, self->gif.iY),
+            .x2 = MIN(self->bitmap->width, self->gif.iX + self->gif.iWidth),
+            .y2 = MIN(self->bitmap->height, self->gif.iY + self->gif.iHeight),
         };
 
-        displayio_bitmap_set_dirty_area(self->bitmap, &dirty_area);
+        if (dirty_area.x1 < dirty_area.x2 && dirty_area.y1 < dirty_area.y2) {
+            displayio_bitmap_set_dirty_area(self->bitmap, &dirty_area);
+        }
     }
 
     return nextDelay;
 }
+
+void common_hal_gifio_ondiskgif_seek(gifio_ondiskgif_t *self, int32_t frame) {
+    // Find the closest point at or before the requested frame that decoding
+    // can resume from: the start of the file, a keyframe, or the current frame.
+    int32_t start = 0;
+    uint32_t *snapshot = NULL;
+    if (self->keyframes) {
+        for (int32_t k = frame / self->keyframe_interval; k > 0; k--) {
+            if (self->keyframes[k] != NULL) {
+                start = k * self->keyframe_interval;
+                snapshot = self->keyframes[k];
+                break;
+            }
+        }
+    }
+
+    bool at_end = self->gif.GIFFile.iPos >= self->gif.GIFFile.iSize - 1;
+    if (!at_end && self->frame <= frame && self->frame > start) {
+        // Continuing from the current frame is cheapest
+    } else if (snapshot != NULL) {
+        restore_keyframe(self, snapshot);
+        self->gif.pfnSeek(&self->gif.GIFFile, self->frame_offsets[start]);
+        self->frame = start;
+    } else {
+        memset(self->bitmap->data, 0, bitmap_data_size(self->bitmap));
+        GIF_reset(&self->gif);
+        self->frame = 0;
+    }
+
+    while (self->frame < frame) {
+        common_hal_gifio_ondiskgif_next_frame(self, false);
+    }
+
+    displayio_area_t dirty_area = {
+        .x1 = 0,
+        .y1 = 0,
+        .x2 = self->bitmap->width,
+        .y2 = self->bitmap->height,
+    };
+    displayio_bitmap_set_dirty_area(self->bitmap, &dirty_area);
+}
@@ -27,4 +27,9 @@ typedef struct {
     int32_t frame_count;
     int32_t min_delay;
     int32_t max_delay;
+    int32_t *frame_offsets; // file offset of each frame decoded so far
+    uint32_t **keyframes; // bitmap and palette before every keyframe_interval'th frame
+    int32_t keyframe_interval;
+    int32_t frames_indexed;
+    int32_t frame; // index of the next frame to be decoded
 } gifio_ondiskgif_t;
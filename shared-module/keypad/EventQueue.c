@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "py/binary.h"
 #include "shared-bindings/keypad/Event.h"
 #include "shared-bindings/keypad/EventQueue.h"
 #include "shared-bindings/supervisor/__init__.h"
@@ -35,6 +36,27 @@ bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t *self, keypad
     return true;
 }
 
+size_t common_hal_keypad_eventqueue_get_many_into(keypad_eventqueue_obj_t *self, void *items, char typecode, size_t max_events) {
+    size_t num_events = 0;
+    while (num_events < max_events) {
+        int encoded_event = ringbuf_get16(&self->encoded_events);
+        if (encoded_event == -1) {
+            break;
+        }
+
+        mp_obj_t ticks;
+        ringbuf_get_n(&self->encoded_events, (uint8_t *)&ticks, sizeof(ticks));
+
+        // Each event is stored as key_number, pressed, timestamp.
+        size_t index = num_events * 3;
+        mp_binary_set_val_array_from_int(typecode, items, index, encoded_event & EVENT_KEY_NUM_MASK);
+        mp_binary_set_val_array_from_int(typecode, items, index + 1, (encoded_event & EVENT_PRESSED) != 0);
+        mp_binary_set_val_array_from_int(typecode, items, index + 2, MP_OBJ_SMALL_INT_VALUE(ticks));
+        num_events++;
+    }
+    return num_events;
+}
+
 mp_obj_t common_hal_keypad_eventqueue_get(keypad_eventqueue_obj_t *self) {
     keypad_event_obj_t *event = mp_obj_malloc(keypad_event_obj_t, &keypad_event_type);
     bool result = common_hal_keypad_eventqueue_get_into(self, event);
@@ -5,10 +5,12 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "py/obj.h"
 #include "py/binary.h"
+#include "py/gc.h"
 #include "py/objarray.h"
 #include "py/objlist.h"
 #include "py/objstringio.h"
@@ -23,26 +25,66 @@
 ////////////////////////////////////////////////////////////////
 // stream management
 
+// pack collects small writes into a buffer of this size on the stack.
+// Payloads that don't fit are written to the stream directly.
+#define MSGPACK_WRITE_BUFFER_SIZE (256)
+
 typedef struct _msgpack_stream_t {
     mp_obj_t stream_obj;
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     int errcode;
+    // unpackb reads from memory instead of the stream when buf is set.
+    const uint8_t *buf;
+    size_t len;
+    size_t pos;
+    // memoryview slices of the input are made relative to base, the start
+    // of the parent object's storage, so that they keep it alive.
+    void *base;
+    size_t base_offset;
+    bool use_memoryview;
+    // Set when base may not be the start of a heap block, so a view of it
+    // wouldn't keep it alive. Views are then made of copies.
+    bool copy_views;
+    // pack buffers writes here when wbuf is set.
+    uint8_t *wbuf;
+    size_t wlen;
 } msgpack_stream_t;
 
 static msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
+    msgpack_stream_t s = {
+        .stream_obj = stream_obj,
+        .read = stream_p->read,
+        .write = stream_p->write,
+    };
     return s;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+// Returns a pointer to the next size bytes of an in-memory input.
+static const uint8_t *read_in_place(msgpack_stream_t *s, size_t size) {
+    if (s->pos == s->len && size > 0) {
+        mp_raise_msg(&mp_type_EOFError, NULL);
+    }
+    if (size > s->len - s->pos) {
+        mp_raise_ValueError(MP_ERROR_TEXT("short read"));
+    }
+    const uint8_t *p = s->buf + s->pos;
+    s->pos += size;
+    return p;
+}
+
+static void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
     if (size == 0) {
         return;
     }
+    if (s->buf != NULL) {
+        memcpy(buf, read_in_place(s, size), size);
+        return;
+    }
     mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -57,13 +99,13 @@ static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
 
 static uint8_t read1(msgpack_stream_t *s) {
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 static uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap16(res);
@@ -73,7 +115,7 @@ static uint16_t read2(msgpack_stream_t *s) {
 
 static uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap32(res);
@@ -83,7 +125,7 @@ static uint32_t read4(msgpack_stream_t *s) {
 
 static uint64_t read8(msgpack_stream_t *s) {
     uint64_t res = 0;
-    read(s, &res, 8);
+    read_bytes(s, &res, 8);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap64(res);
@@ -110,18 +152,45 @@ static size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
-    mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
+static void write_stream(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+    const uint8_t *p = buf;
+    while (size > 0) {
+        mp_uint_t ret = s->write(s->stream_obj, p, size, &s->errcode);
+        if (s->errcode != 0) {
+            mp_raise_OSError(s->errcode);
+        }
+        if (ret == 0) {
+            mp_raise_msg(&mp_type_EOFError, NULL);
+        }
+        p += ret;
+        size -= ret;
     }
-    if (ret == 0) {
-        mp_raise_msg(&mp_type_EOFError, NULL);
+}
+
+static void flush(msgpack_stream_t *s) {
+    size_t wlen = s->wlen;
+    // Emptied first so that nothing is written twice if the stream raises.
+    s->wlen = 0;
+    if (wlen > 0) {
+        write_stream(s, s->wbuf, wlen);
+    }
+}
+
+static void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+    if (s->wlen + size > MSGPACK_WRITE_BUFFER_SIZE) {
+        flush(s);
+        if (size > MSGPACK_WRITE_BUFFER_SIZE) {
+            // Large payloads (bytes, bytearray, array.array) go out in one write.
+            write_stream(s, buf, size);
+            return;
+        }
     }
+    memcpy(s->wbuf + s->wlen, buf, size);
+    s->wlen += size;
 }
 
 static void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    write_bytes(s, &obj, 1);
 }
 
 static void write2(msgpack_stream_t *s, uint16_t obj) {
@@ -129,7 +198,7 @@ static void write2(msgpack_stream_t *s, uint16_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap16(obj);
     }
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 static void write4(msgpack_stream_t *s, uint32_t obj) {
@@ -137,7 +206,7 @@ static void write4(msgpack_stream_t *s, uint32_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap32(obj);
     }
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
 }
 
 // compute and write msgpack size code (array structures)
@@ -192,7 +261,7 @@ static void pack_int(msgpack_stream_t *s, int32_t x) {
 static void pack_bin(msgpack_stream_t *s, const uint8_t *data, size_t len) {
     write_size(s, 0xc4, len);
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -212,7 +281,7 @@ static void pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t *data, size
     }
     write1(s, code);    // type byte
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -223,7 +292,7 @@ static void pack_str(msgpack_stream_t *s, const char *str, size_t len) {
         write_size(s, 0xd9, len);
     }
     if (len > 0) {
-        write(s, str, len);
+        write_bytes(s, str, len);
     }
 }
 
@@ -342,25 +411,72 @@ static mp_obj_t unpack_array_elements(msgpack_stream_t *s, size_t size, mp_obj_t
     }
 }
 
-static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
+// Returns the next size bytes of an in-memory input as a read-only memoryview.
+static mp_obj_t unpack_memoryview(msgpack_stream_t *s, size_t size) {
+    if (s->copy_views) {
+        byte *copy = m_new(byte, size);
+        memcpy(copy, read_in_place(s, size), size);
+        return mp_obj_new_memoryview('B', size, copy);
+    }
+    size_t offset = s->base_offset + s->pos;
+    read_in_place(s, size);
+    mp_obj_array_t *view = MP_OBJ_TO_PTR(mp_obj_new_memoryview('B', size, s->base));
+    // For memoryviews, free is the offset into the parent object.
+    view->free = offset;
+    return MP_OBJ_FROM_PTR(view);
+}
+
+static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size, bool allow_view) {
+    if (s->buf != NULL) {
+        if (allow_view && s->use_memoryview) {
+            return unpack_memoryview(s, size);
+        }
+        return mp_obj_new_bytes(read_in_place(s, size), size);
+    }
     vstr_t vstr;
     vstr_init_len(&vstr, size);
     byte *p = (byte *)vstr.buf;
     // read in chunks: (some drivers - e.g. UART) limit the
     // maximum number of bytes that can be read at once
-    // read(s, p, size);
+    // read_bytes(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
     return mp_obj_new_bytes_from_vstr(&vstr);
 }
 
+static mp_obj_t unpack_str(msgpack_stream_t *s, size_t size) {
+    if (s->buf != NULL) {
+        if (s->use_memoryview) {
+            return unpack_memoryview(s, size);
+        }
+        return mp_obj_new_str((const char *)read_in_place(s, size), size);
+    }
+    vstr_t vstr;
+    vstr_init_len(&vstr, size);
+    read_bytes(s, vstr.buf, size);
+    return mp_obj_new_str_from_vstr(&vstr);
+}
+
+static mp_obj_t unpack_map(msgpack_stream_t *s, size_t len, mp_obj_t ext_hook, bool use_list) {
+    mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
+    bool use_memoryview = s->use_memoryview;
+    for (size_t i = 0; i < len; i++) {
+        // Keys are always copied so that they hash and compare by value.
+        s->use_memoryview = false;
+        mp_obj_t key = unpack(s, ext_hook, use_list);
+        s->use_memoryview = use_memoryview;
+        mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
+    }
+    return MP_OBJ_FROM_PTR(d);
+}
+
 static mp_obj_t unpack_ext(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook) {
     int8_t code = read1(s);
-    mp_obj_t data = unpack_bytes(s, size);
+    mp_obj_t data = unpack_bytes(s, size, false);
     if (ext_hook != mp_const_none) {
         return mp_call_function_2(ext_hook, MP_OBJ_NEW_SMALL_INT(code), data);
     } else {
@@ -380,9 +496,12 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     if ((code & 0b11100000) == 0b10100000) {
         // str
         size_t len = code & 0b11111;
+        if (s->buf != NULL) {
+            return unpack_str(s, len);
+        }
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -391,12 +510,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     }
     if ((code & 0b11110000) == 0b10000000) {
         // map (dict)
-        size_t len = code & 0b1111;
-        mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-        for (size_t i = 0; i < len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-        }
-        return MP_OBJ_FROM_PTR(d);
+        return unpack_map(s, code & 0b1111, ext_hook, use_list);
     }
     switch (code) {
         case 0xc0:
@@ -409,7 +523,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         case 0xc5:
         case 0xc6: {
             // bin 8, 16, 32
-            return unpack_bytes(s, read_size(s, code - 0xc4));
+            return unpack_bytes(s, read_size(s, code - 0xc4), true);
         }
         case 0xcc: // uint8
             return MP_OBJ_NEW_SMALL_INT((uint8_t)read1(s));
@@ -449,22 +563,12 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         case 0xda:
         case 0xdb: {
             // str 8, 16, 32
-            size_t size = read_size(s, code - 0xd9);
-            vstr_t vstr;
-            vstr_init_len(&vstr, size);
-            byte *p = (byte *)vstr.buf;
-            read(s, p, size);
-            return mp_obj_new_str_from_vstr(&vstr);
+            return unpack_str(s, read_size(s, code - 0xd9));
         }
         case 0xde:
         case 0xdf: {
             // map 16 & 32
-            size_t len = read_size(s, code - 0xde + 1);
-            mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-            for (size_t i = 0; i < len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-            }
-            return MP_OBJ_FROM_PTR(d);
+            return unpack_map(s, read_size(s, code - 0xde + 1), ext_hook, use_list);
         }
         case 0xdc:
         case 0xdd: {
@@ -495,10 +599,49 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler) {
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_WRITE);
-    pack(obj, &stream, default_handler);
+    uint8_t wbuf[MSGPACK_WRITE_BUFFER_SIZE];
+    stream.wbuf = wbuf;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        pack(obj, &stream, default_handler);
+        nlr_pop();
+        flush(&stream);
+    } else {
+        // As when every write went straight to the stream, whatever was
+        // packed before default or a write raised has been written.
+        flush(&stream);
+        nlr_jump(nlr.ret_val);
+    }
 }
 
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list) {
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
     return unpack(&stream, ext_hook, use_list);
 }
+
+mp_obj_t common_hal_msgpack_unpackb(mp_obj_t buffer_obj, mp_obj_t ext_hook, bool use_list, bool use_memoryview) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_READ);
+    msgpack_stream_t stream = {
+        .stream_obj = buffer_obj,
+        .buf = bufinfo.buf,
+        .len = bufinfo.len,
+        .base = bufinfo.buf,
+        .use_memoryview = use_memoryview,
+    };
+    if (mp_obj_is_type(buffer_obj, &mp_type_memoryview)) {
+        // Slice relative to the memoryview's parent rather than into its middle.
+        mp_obj_array_t *view = MP_OBJ_TO_PTR(buffer_obj);
+        stream.base = view->items;
+        stream.base_offset = (const uint8_t *)bufinfo.buf - (const uint8_t *)view->items;
+    }
+    // The data of bytes is either a heap block of its own or never freed. Other buffers,
+    // such as those of native objects, may point into the middle of something.
+    stream.copy_views = use_memoryview && !mp_obj_is_type(buffer_obj, &mp_type_bytes) &&
+        gc_nbytes(stream.base) == 0;
+    mp_obj_t obj = unpack(&stream, ext_hook, use_list);
+    if (stream.pos != stream.len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("extra data"));
+    }
+    return obj;
+}
@@ -9,3 +9,4 @@
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler);
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list);
+mp_obj_t common_hal_msgpack_unpackb(mp_obj_t buffer_obj, mp_obj_t ext_hook, bool use_list, bool use_memoryview);
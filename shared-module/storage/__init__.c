@@ -125,6 +125,8 @@ void common_hal_storage_mount(mp_obj_t vfs_obj, const char *mount_path, bool rea
     // call the underlying object to do any mounting operation
     mp_vfs_proxy_call(vfs, MP_QSTR_mount, 2, (mp_obj_t *)&args);
 
+    mp_vfs_import_stat_cache_invalidate();
+
     // Insert the vfs into the mount table by pushing it onto the front of the
     // mount table.
     mp_vfs_mount_t **vfsp = &MP_STATE_VM(vfs_mount_table);
@@ -147,6 +149,8 @@ void common_hal_storage_umount_object(mp_obj_t vfs_obj) {
         mp_raise_OSError(MP_EINVAL);
     }
 
+    mp_vfs_import_stat_cache_invalidate();
+
     // if we unmounted the current device then set current to root
     if (MP_STATE_VM(vfs_cur) == vfs) {
         MP_STATE_VM(vfs_cur) = MP_VFS_ROOT;
@@ -22,6 +22,45 @@ void terminalio_terminal_clear_status_bar(terminalio_terminal_obj_t *self) {
     }
 }
 
+// Printable characters are collected into a run of tiles on one row so that the tile grid is
+// updated once per run instead of once per character.
+#define TERMINAL_RUN_MAX (32)
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t len;
+    uint16_t tiles[TERMINAL_RUN_MAX];
+} terminal_run_t;
+
+static void terminal_flush_run(terminalio_terminal_obj_t *self, terminal_run_t *run) {
+    displayio_tilegrid_set_tiles(self->scroll_area, run->x, run->y, run->tiles, run->len);
+    run->len = 0;
+}
+
+// Add a tile at the cursor and advance the cursor.
+static void terminal_add_to_run(terminalio_terminal_obj_t *self, terminal_run_t *run, uint16_t tile_index) {
+    if (run->len > 0 &&
+        (run->len == TERMINAL_RUN_MAX || run->y != self->cursor_y || run->x + run->len != self->cursor_x)) {
+        terminal_flush_run(self, run);
+    }
+    if (run->len == 0) {
+        run->x = self->cursor_x;
+        run->y = self->cursor_y;
+    }
+    run->tiles[run->len++] = tile_index;
+    self->cursor_x++;
+}
+
+static void terminal_clear_row(terminalio_terminal_obj_t *self, uint16_t y) {
+    displayio_tilegrid_fill_tiles(self->scroll_area, 0, y, 0, self->scroll_area->width_in_tiles);
+}
+
+// True when the VT100 scroll region is the whole screen so scrolling can move top_left_y.
+static bool terminal_scrolls_full_screen(terminalio_terminal_obj_t *self) {
+    return self->vt_scroll_top == 0 && self->vt_scroll_end == self->scroll_area->height_in_tiles - 1;
+}
+
 void common_hal_terminalio_terminal_construct(terminalio_terminal_obj_t *self,
     displayio_tilegrid_t *scroll_area, const fontio_builtinfont_t *font,
     displayio_tilegrid_t *status_bar) {
@@ -72,6 +111,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
 
     const byte *i = data;
     uint16_t start_y = self->cursor_y;
+    terminal_run_t run;
+    run.len = 0;
     while (i < data + len) {
         unichar c = utf8_get_char(i);
         i = utf8_next_char(i);
@@ -85,8 +126,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                 self->osc_command == 0 &&
                 self->status_bar != NULL &&
                 self->status_y < self->status_bar->height_in_tiles) {
-                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-                if (tile_index != 0xff) {
+                uint16_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
+                if (tile_index != FONTIO_BUILTINFONT_NO_GLYPH) {
                     // Clear the tile grid before we start putting new info.
                     if (self->status_x == 0 && self->status_y == 0) {
                         common_hal_displayio_tilegrid_set_all_tiles(self->status_bar, 0);
@@ -103,10 +144,12 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
         }
         // Always handle ASCII.
         if (c < 128) {
+            if (c < 0x20 || c > 0x7e) {
+                // Control characters may read or move tiles so write out the pending ones first.
+                terminal_flush_run(self, &run);
+            }
             if (c >= 0x20 && c <= 0x7e) {
-                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-                common_hal_displayio_tilegrid_set_tile(self->scroll_area, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
+                terminal_add_to_run(self, &run, fontio_builtinfont_get_glyph_index(self->font, c));
             } else if (c == '\r') {
                 self->cursor_x = 0;
             } else if (c == '\n') {
@@ -173,8 +216,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                             }
                             #endif
                             // Clear the (start/rest/all) of the line.
-                            for (uint16_t k = clr_start; k < clr_end; k++) {
-                                common_hal_displayio_tilegrid_set_tile(self->scroll_area, k, self->cursor_y, 0);
+                            if (clr_end > clr_start) {
+                                displayio_tilegrid_fill_tiles(self->scroll_area, clr_start, self->cursor_y, 0, clr_end - clr_start);
                             }
                         } else if (c == 'D') {
                             if (vt_args[0] > self->cursor_x) {
@@ -240,16 +283,12 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                             self->cursor_y = self->scroll_area->height_in_tiles - 1;
                         }
                     } else {
-                        if (self->vt_scroll_top != 0 || self->vt_scroll_end != self->scroll_area->height_in_tiles) {
+                        if (!terminal_scrolls_full_screen(self)) {
                             // Scroll range defined, manually move tiles to perform scroll
                             for (int16_t irow = self->vt_scroll_end - 1; irow >= self->vt_scroll_top; irow--) {
-                                for (int16_t icol = 0; icol < self->scroll_area->width_in_tiles; icol++) {
-                                    common_hal_displayio_tilegrid_set_tile(self->scroll_area, icol, SCRNMOD(irow + 1), common_hal_displayio_tilegrid_get_tile(self->scroll_area, icol, SCRNMOD(irow)));
-                                }
-                            }
-                            for (int16_t icol = 0; icol < self->scroll_area->width_in_tiles; icol++) {
-                                common_hal_displayio_tilegrid_set_tile(self->scroll_area, icol, self->cursor_y, 0);
+                                displayio_tilegrid_copy_row(self->scroll_area, SCRNMOD(irow), SCRNMOD(irow + 1));
                             }
+                            terminal_clear_row(self, self->cursor_y);
                         } else {
                             // Full screen scroll, just set new top_y pointer and clear row
                             if (self->cursor_y > 0) {
@@ -257,9 +296,7 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                             } else {
                                 common_hal_displayio_tilegrid_set_top_left(self->scroll_area, 0, self->scroll_area->height_in_tiles - 1);
                             }
-                            for (uint16_t icol = 0; icol < self->scroll_area->width_in_tiles; icol++) {
-                                common_hal_displayio_tilegrid_set_tile(self->scroll_area, icol, self->scroll_area->top_left_y, 0);
-                            }
+                            terminal_clear_row(self, self->scroll_area->top_left_y);
                             self->cursor_y = self->scroll_area->top_left_y;
                         }
                         self->cursor_x = 0;
@@ -277,11 +314,9 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                 }
             }
         } else {
-            uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-            if (tile_index != 0xff) {
-                common_hal_displayio_tilegrid_set_tile(self->scroll_area, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
-
+            uint16_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
+            if (tile_index != FONTIO_BUILTINFONT_NO_GLYPH) {
+                terminal_add_to_run(self, &run, tile_index);
             }
         }
         if (self->cursor_x >= self->scroll_area->width_in_tiles) {
@@ -292,32 +327,30 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
             self->cursor_y %= self->scroll_area->height_in_tiles;
         }
         if (self->cursor_y != start_y) {
+            terminal_flush_run(self, &run);
             if (((self->cursor_y + self->scroll_area->height_in_tiles) - 1) % self->scroll_area->height_in_tiles == SCRNMOD(self->vt_scroll_end)) {
                 #if CIRCUITPY_TERMINALIO_VT100
-                if (self->vt_scroll_top != 0 || self->vt_scroll_end != self->scroll_area->height_in_tiles) {
+                if (!terminal_scrolls_full_screen(self)) {
                     // Scroll range defined, manually move tiles to perform scroll
                     self->cursor_y = SCRNMOD(self->vt_scroll_end);
 
                     for (int16_t irow = self->vt_scroll_top; irow < self->vt_scroll_end; irow++) {
-                        for (int16_t icol = 0; icol < self->scroll_area->width_in_tiles; icol++) {
-                            common_hal_displayio_tilegrid_set_tile(self->scroll_area, icol, SCRNMOD(irow), common_hal_displayio_tilegrid_get_tile(self->scroll_area, icol, SCRNMOD(irow + 1)));
-                        }
+                        displayio_tilegrid_copy_row(self->scroll_area, SCRNMOD(irow + 1), SCRNMOD(irow));
                     }
                 }
                 #endif
-                if (self->vt_scroll_top == 0 && self->vt_scroll_end == self->scroll_area->height_in_tiles) {
+                if (terminal_scrolls_full_screen(self)) {
                     // Full screen scroll, just set new top_y pointer
                     common_hal_displayio_tilegrid_set_top_left(self->scroll_area, 0, (self->cursor_y + self->scroll_area->height_in_tiles + 1) % self->scroll_area->height_in_tiles);
                 }
                 // clear the new row in case of scroll up
-                for (int16_t icol = 0; icol < self->scroll_area->width_in_tiles; icol++) {
-                    common_hal_displayio_tilegrid_set_tile(self->scroll_area, icol, self->cursor_y, 0);
-                }
+                terminal_clear_row(self, self->cursor_y);
                 self->cursor_x = 0;
             }
             start_y = self->cursor_y;
         }
     }
+    terminal_flush_run(self, &run);
     return i - data;
 }
 
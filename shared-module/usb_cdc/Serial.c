@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "py/stream.h"
 #include "shared/runtime/interrupt_char.h"
 #include "shared-bindings/usb_cdc/Serial.h"
 #include "shared-module/usb_cdc/Serial.h"
@@ -106,6 +107,36 @@ uint32_t common_hal_usb_cdc_serial_get_out_waiting(usb_cdc_serial_obj_t *self) {
     return CFG_TUD_CDC_TX_BUFSIZE - tud_cdc_n_write_available(self->idx);
 }
 
+mp_uint_t common_hal_usb_cdc_serial_poll(usb_cdc_serial_obj_t *self) {
+    mp_uint_t ready = 0;
+    if (common_hal_usb_cdc_serial_get_in_waiting(self) > 0) {
+        ready |= MP_STREAM_POLL_RD;
+    }
+    if (common_hal_usb_cdc_serial_get_out_waiting(self) == 0) {
+        ready |= MP_STREAM_POLL_WR;
+    }
+    self->poll_ready = ready;
+    return ready;
+}
+
+void usb_cdc_serial_poll_notify(usb_cdc_serial_obj_t *self) {
+    mp_uint_t was_ready = self->poll_ready;
+    if (common_hal_usb_cdc_serial_poll(self) & ~was_ready) {
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(self));
+    }
+}
+
+mp_uint_t common_hal_usb_cdc_serial_poll_notifies(usb_cdc_serial_obj_t *self) {
+    #if CFG_TUSB_OS == OPT_OS_NONE || CFG_TUSB_OS == OPT_OS_PICO
+    // The FIFOs only change in tud_task(), which is followed by usb_cdc_poll_notify().
+    // ERR and HUP are never reported, so they can't be missed.
+    return MP_STREAM_POLL_RD | MP_STREAM_POLL_WR | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP;
+    #else
+    // TinyUSB runs in its own task.
+    return 0;
+    #endif
+}
+
 void common_hal_usb_cdc_serial_reset_input_buffer(usb_cdc_serial_obj_t *self) {
     tud_cdc_n_read_flush(self->idx);
 }
@@ -13,4 +13,9 @@ typedef struct {
     mp_float_t timeout;       // if negative, wait forever.
     mp_float_t write_timeout; // if negative, wait forever.
     uint8_t idx;              // which CDC device?
+    uint8_t poll_ready;       // MP_STREAM_POLL_* flags that were ready when last checked
 } usb_cdc_serial_obj_t;
+
+// Calls mp_stream_poll_notify() if the serial has become ready for reading or
+// writing since it was last polled or checked.
+void usb_cdc_serial_poll_notify(usb_cdc_serial_obj_t *self);
@@ -161,6 +161,15 @@ bool usb_cdc_data_enabled(void) {
     return usb_cdc_data_is_enabled;
 }
 
+void usb_cdc_poll_notify(void) {
+    if (usb_cdc_console_is_enabled) {
+        usb_cdc_serial_poll_notify(&usb_cdc_console_obj);
+    }
+    if (usb_cdc_data_is_enabled) {
+        usb_cdc_serial_poll_notify(&usb_cdc_data_obj);
+    }
+}
+
 size_t usb_cdc_descriptor_length(void) {
     return sizeof(usb_cdc_descriptor_template);
 }
@@ -44,6 +44,31 @@ uint32_t common_hal_vectorio_circle_get_pixel(void *obj, int16_t x, int16_t y) {
     return pythagorasSmallerThanRadius ? self->color_index : 0;
 }
 
+// The covered pixels of a row are those with x * x + y * y <= radius * radius,
+// the same test as get_pixel, so the span is -h <= x <= h for the largest such h.
+size_t common_hal_vectorio_circle_get_spans(void *obj, int16_t y, vectorio_span_t *spans, size_t max_spans) {
+    vectorio_circle_t *self = obj;
+    int32_t radius = self->radius;
+    y = abs(y);
+    if (y > radius) {
+        return 0;
+    }
+    // Integer square root, one result bit at a time.
+    uint32_t limit = radius * radius - (int32_t)y * y;
+    uint32_t h = 0;
+    for (uint32_t bit = 1u << 15; bit; bit >>= 1) {
+        uint32_t trial = h | bit;
+        if (trial * trial <= limit) {
+            h = trial;
+        }
+    }
+    if (max_spans > 0) {
+        spans[0].x1 = -(int16_t)h;
+        spans[0].x2 = h + 1;
+    }
+    return 1;
+}
+
 
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area) {
     vectorio_circle_t *self = circle;
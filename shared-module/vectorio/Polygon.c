@@ -19,6 +19,46 @@
 // #define VECTORIO_POLYGON_DEBUG(...) mp_printf(&mp_plat_print, __VA_ARGS__)
 
 
+static void _build_edge_table(vectorio_polygon_t *self, const int16_t *points_list, uint16_t n_points) {
+    size_t edges_size = n_points * sizeof(vectorio_polygon_edge_t);
+    vectorio_polygon_edge_t *edges = gc_realloc(self->edges, edges_size, true);
+    self->edges = edges;
+    if (edges == NULL) {
+        m_malloc_fail(edges_size);
+    }
+    size_t crossings_size = n_points * sizeof(vectorio_polygon_crossing_t);
+    vectorio_polygon_crossing_t *crossings = gc_realloc(self->crossings, crossings_size, true);
+    self->crossings = crossings;
+    if (crossings == NULL) {
+        m_malloc_fail(crossings_size);
+    }
+
+    uint16_t n_edges = 0;
+    for (uint16_t i = 0; i < n_points; i++) {
+        uint16_t j = (i + 1) % n_points;
+        vectorio_polygon_edge_t edge = {
+            .x1 = points_list[2 * i],
+            .y1 = points_list[2 * i + 1],
+            .x2 = points_list[2 * j],
+            .y2 = points_list[2 * j + 1],
+        };
+        if (edge.y1 == edge.y2) {
+            // Horizontal edges never change the winding number.
+            continue;
+        }
+        edge.y_top = MIN(edge.y1, edge.y2);
+        edge.y_bottom = MAX(edge.y1, edge.y2);
+        // Insertion sort by y_top; polygons are rarely large enough for this to matter.
+        uint16_t k = n_edges++;
+        while (k > 0 && edges[k - 1].y_top > edge.y_top) {
+            edges[k] = edges[k - 1];
+            k--;
+        }
+        edges[k] = edge;
+    }
+    self->n_edges = n_edges;
+}
+
 // Converts a list of points tuples to a flat list of ints for speedier internal use.
 // Also validates the points. If this fails due to invalid types or values, the
 // number of points is 0 and the points_list is NULL.
@@ -38,6 +78,7 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
     // In case the validation calls below fail, set these values temporarily
     self->points_list = NULL;
     self->len = 0;
+    self->n_edges = 0;
 
     for (uint16_t i = 0; i < len; ++i) {
         size_t tuple_len = 0;
@@ -55,6 +96,7 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
         points_list[2 * i + 1] = (int16_t)y;
     }
 
+    _build_edge_table(self, points_list, len);
     self->points_list = points_list;
     self->len = 2 * len;
 }
@@ -64,7 +106,10 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
 void common_hal_vectorio_polygon_construct(vectorio_polygon_t *self, mp_obj_t points_list, uint16_t color_index) {
     VECTORIO_POLYGON_DEBUG("%p polygon_construct: ", self);
     self->points_list = NULL;
+    self->edges = NULL;
+    self->crossings = NULL;
     self->len = 0;
+    self->n_edges = 0;
     self->on_dirty.obj = NULL;
     self->color_index = color_index + 1;
     _clobber_points_list(self, points_list);
@@ -185,6 +230,71 @@ uint32_t common_hal_vectorio_polygon_get_pixel(void *obj, int16_t x, int16_t y)
     return winding_number == 0 ? 0 : self->color_index;
 }
 
+// Rounds towards positive infinity, for either sign of n and d.
+static inline int ceil_div(int n, int d) {
+    int q = n / d;
+    if (n % d != 0 && (n < 0) == (d < 0)) {
+        q++;
+    }
+    return q;
+}
+
+// Computes the same coverage as get_pixel for a whole row at once. From
+// line_side, a pixel left of an edge's crossing point is wound up (or down)
+// by that edge, so each edge that crosses the row contributes its winding to
+// all x < crossing. Sorting the crossings then gives the winding number of
+// every run between them.
+size_t common_hal_vectorio_polygon_get_spans(void *obj, int16_t y, vectorio_span_t *spans, size_t max_spans) {
+    vectorio_polygon_t *self = obj;
+    if (self->n_edges == 0) {
+        return 0;
+    }
+
+    vectorio_polygon_crossing_t *crossings = self->crossings;
+    size_t n_crossings = 0;
+    int winding_number = 0;
+    for (uint16_t i = 0; i < self->n_edges; i++) {
+        const vectorio_polygon_edge_t *edge = &self->edges[i];
+        if (edge->y_top > y) {
+            break;
+        }
+        if (edge->y_bottom <= y) {
+            continue;
+        }
+        int dy = edge->y2 - edge->y1;
+        int x = edge->x1 + ceil_div((y - edge->y1) * (edge->x2 - edge->x1), dy);
+        vectorio_polygon_crossing_t crossing = { .x = x, .winding = dy > 0 ? 1 : -1 };
+        winding_number += crossing.winding;
+        size_t k = n_crossings++;
+        while (k > 0 && crossings[k - 1].x > crossing.x) {
+            crossings[k] = crossings[k - 1];
+            k--;
+        }
+        crossings[k] = crossing;
+    }
+
+    size_t n_spans = 0;
+    int16_t start = SHRT_MIN;
+    for (size_t i = 0; i < n_crossings; i++) {
+        int16_t end = crossings[i].x;
+        if (winding_number != 0 && start < end) {
+            if (n_spans > 0 && n_spans <= max_spans && spans[n_spans - 1].x2 == start) {
+                // Extend the previous run instead of starting a new one.
+                spans[n_spans - 1].x2 = end;
+            } else {
+                if (n_spans < max_spans) {
+                    spans[n_spans].x1 = start;
+                    spans[n_spans].x2 = end;
+                }
+                n_spans++;
+            }
+        }
+        winding_number -= crossings[i].winding;
+        start = end;
+    }
+    return n_spans;
+}
+
 mp_obj_t common_hal_vectorio_polygon_get_draw_protocol(void *polygon) {
     vectorio_polygon_t *self = polygon;
     return self->draw_protocol_instance;
@@ -11,11 +11,27 @@
 #include "py/obj.h"
 #include "shared-module/vectorio/__init__.h"
 
+typedef struct {
+    int16_t x1, y1, x2, y2; // as given, so the direction gives the winding
+    int16_t y_top, y_bottom; // rows y_top <= y < y_bottom cross this edge
+} vectorio_polygon_edge_t;
+
+typedef struct {
+    int16_t x; // the edge contributes to the winding number left of x
+    int16_t winding;
+} vectorio_polygon_crossing_t;
+
 typedef struct {
     mp_obj_base_t base;
     // An int array[ x, y, ... ]
     int16_t *points_list;
+    // Non-horizontal edges sorted by their top y, used to find the edges that
+    // cross a scanline without testing every edge of the polygon.
+    vectorio_polygon_edge_t *edges;
+    // Scratch space for one scanline's edge crossings; one entry per edge.
+    vectorio_polygon_crossing_t *crossings;
     uint16_t len;
+    uint16_t n_edges;
     uint16_t color_index;
     vectorio_event_t on_dirty;
     mp_obj_t draw_protocol_instance;
@@ -326,6 +326,53 @@ void common_hal_vectorio_vector_shape_set_pixel_shader(vectorio_vector_shape_t *
     common_hal_vectorio_vector_shape_set_dirty(self);
 }
 
+// Upper bound on the runs per row that fill_area asks a shape for. Rows of
+// polygons with more runs than this fall back to testing each pixel.
+#define VECTORIO_MAX_ROW_SPANS (16)
+
+static void _shade_pixel(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_pixel) {
+    if (self->pixel_shader == mp_const_none) {
+        output_pixel->pixel = input_pixel->pixel;
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_palette_get_color(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        displayio_colorconverter_convert(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    }
+}
+
+static void _put_pixel(const _displayio_colorspace_t *colorspace, uint32_t *buffer, uint16_t pixel_index, uint16_t linestride_px, uint8_t pixels_per_byte, uint32_t pixel) {
+    if (colorspace->depth == 16) {
+        *(((uint16_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth == 32) {
+        *(((uint32_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth == 8) {
+        *(((uint8_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth < 8) {
+        // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
+        if (!colorspace->pixels_in_byte_share_row) {
+            uint16_t row = pixel_index / linestride_px;
+            uint16_t col = pixel_index % linestride_px;
+            pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
+        }
+        uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
+        if (colorspace->reverse_pixels_in_byte) {
+            // Reverse the shift by subtracting it from the leftmost shift.
+            shift = (pixels_per_byte - 1) * colorspace->depth - shift;
+        }
+        ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= pixel << shift;
+    }
+}
+
+// Uncovered pixels only spoil full coverage if nothing else has drawn them.
+static bool _all_masked(const uint32_t *mask, uint16_t pixel_index, uint16_t count) {
+    for (uint16_t i = pixel_index; i < pixel_index + count; i++) {
+        if ((mask[i / 32] & (1u << (i % 32))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Shape areas are relative to 0,0.  This will allow rotation about a known axis.
     //   The consequence is that the area reported by the shape itself is _relative_ to 0,0.
@@ -373,9 +420,76 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     displayio_area_t shape_area;
     self->ishape.get_area(self->ishape.shape, &shape_area);
 
+    // Shapes that can report whole runs of covered pixels per row skip the per-pixel
+    // get_pixel test. Transposed rows are columns of the shape, so they can't use runs.
+    bool use_spans = self->ishape.get_spans != NULL && !self->absolute_transform->transpose_xy;
+    vectorio_span_t spans[VECTORIO_MAX_ROW_SPANS];
+    // Only a palette that dithers (or a ColorConverter) depends on the pixel position.
+    bool per_pixel_color = mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type) ||
+        (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) && ((displayio_palette_t *)self->pixel_shader)->dither);
+
     uint16_t mask_start_px = line_dirty_offset_px;
     for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
         mask_start_px += column_dirty_offset_px;
+
+        size_t n_spans = 0;
+        int16_t shape_y = 0;
+        if (use_spans) {
+            int16_t shape_x;
+            screen_to_shape_coordinates(self, overlap.x1, input_pixel.y, &shape_x, &shape_y);
+            n_spans = self->ishape.get_spans(self->ishape.shape, shape_y, spans, VECTORIO_MAX_ROW_SPANS);
+        }
+        if (use_spans && n_spans <= VECTORIO_MAX_ROW_SPANS) {
+            // Convert the runs to screen columns. A mirrored shape maps shape_x to
+            // origin - 1 - x, which also reverses the order of the runs.
+            int16_t origin = self->absolute_transform->x + self->absolute_transform->dx * self->x;
+            bool mirror = self->absolute_transform->dx < 1;
+            int16_t x = overlap.x1;
+            for (size_t i = 0; i < n_spans; i++) {
+                const vectorio_span_t *span = &spans[mirror ? n_spans - 1 - i : i];
+                int32_t span_x1 = mirror ? origin - span->x2 : origin + span->x1;
+                int32_t span_x2 = mirror ? origin - span->x1 : origin + span->x2;
+                span_x1 = MAX(span_x1, x);
+                span_x2 = MIN(span_x2, overlap.x2);
+                if (span_x1 >= span_x2) {
+                    continue;
+                }
+                if (span_x1 > x) {
+                    full_coverage = full_coverage && _all_masked(mask, mask_start_px + (x - overlap.x1), span_x1 - x);
+                }
+                input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, span->x1, shape_y) - 1;
+                output_pixel.opaque = true;
+                output_pixel.pixel = 0;
+                if (!per_pixel_color) {
+                    _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
+                }
+                for (input_pixel.x = span_x1; input_pixel.x < span_x2; ++input_pixel.x) {
+                    uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
+                    uint32_t *mask_doubleword = &(mask[pixel_index / 32]);
+                    uint32_t mask_bit = 1u << (pixel_index % 32);
+                    if (*mask_doubleword & mask_bit) {
+                        continue;
+                    }
+                    if (per_pixel_color) {
+                        output_pixel.opaque = true;
+                        output_pixel.pixel = 0;
+                        _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
+                    }
+                    if (!output_pixel.opaque) {
+                        full_coverage = false;
+                    }
+                    *mask_doubleword |= mask_bit;
+                    _put_pixel(colorspace, buffer, pixel_index, linestride_px, pixels_per_byte, output_pixel.pixel);
+                }
+                x = span_x2;
+            }
+            if (x < overlap.x2) {
+                full_coverage = full_coverage && _all_masked(mask, mask_start_px + (x - overlap.x1), overlap.x2 - x);
+            }
+            mask_start_px += linestride_px - column_dirty_offset_px;
+            continue;
+        }
+
         for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
             // Check the mask first to see if the pixel has already been set.
             uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
@@ -414,13 +528,7 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
                 input_pixel.pixel -= 1;
                 output_pixel.opaque = true;
 
-                if (self->pixel_shader == mp_const_none) {
-                    output_pixel.pixel = input_pixel.pixel;
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                    displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                    displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-                }
+                _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
 
                 // We double-check this to fast-path the case when a pixel is not covered by the shape & not call the color converter unnecessarily.
                 if (!output_pixel.opaque) {
@@ -429,30 +537,8 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
                 }
 
                 *mask_doubleword |= 1u << mask_bit;
-                if (colorspace->depth == 16) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", output_pixel.pixel);
-                    *(((uint16_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 32) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 32", output_pixel.pixel);
-                    *(((uint32_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 8) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %02x 8", output_pixel.pixel);
-                    *(((uint8_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth < 8) {
-                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
-                    if (!colorspace->pixels_in_byte_share_row) {
-                        uint16_t row = pixel_index / linestride_px;
-                        uint16_t col = pixel_index % linestride_px;
-                        pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
-                    }
-                    uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
-                    if (colorspace->reverse_pixels_in_byte) {
-                        // Reverse the shift by subtracting it from the leftmost shift.
-                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
-                    }
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %2d %d", output_pixel.pixel, colorspace->depth);
-                    ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= output_pixel.pixel << shift;
-                }
+                VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x %d", output_pixel.pixel, colorspace->depth);
+                _put_pixel(colorspace, buffer, pixel_index, linestride_px, pixels_per_byte, output_pixel.pixel);
             }
         }
         mask_start_px += linestride_px - column_dirty_offset_px;
@@ -13,9 +13,13 @@
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/vectorio/__init__.h"
 
 typedef void get_area_function(mp_obj_t shape, displayio_area_t *out_area);
 typedef uint32_t get_pixel_function(mp_obj_t shape, int16_t x, int16_t y);
+// Writes up to max_spans covered runs of row y, sorted by x, and returns how many
+// runs the row has. If that is more than max_spans the caller must fall back to get_pixel.
+typedef size_t get_spans_function(mp_obj_t shape, int16_t y, vectorio_span_t *spans, size_t max_spans);
 
 // This struct binds a shape's common Shape support functions (its vector shape interface)
 //   to its instance pointer.  We only check at construction time what the type of the
@@ -27,6 +31,8 @@ typedef struct {
     mp_obj_t shape;
     get_area_function *get_area;
     get_pixel_function *get_pixel;
+    // Optional; all pixels of a span have the value get_pixel returns for its first pixel.
+    get_spans_function *get_spans;
 } vectorio_ishape_t;
 
 typedef struct {
@@ -14,3 +14,9 @@ typedef struct {
     mp_obj_t obj;
     event_function *event;
 } vectorio_event_t;
+
+// A run of covered pixels [x1, x2) on one row, in shape coordinates.
+typedef struct {
+    int16_t x1;
+    int16_t x2;
+} vectorio_span_t;
@@ -33,8 +33,14 @@ const uint8_t file_transfer_base_uuid[16] = {0x72, 0x65, 0x66, 0x73, 0x6e, 0x61,
 
 static mp_obj_list_t characteristic_list;
 static mp_obj_t characteristic_list_items[2];
+// Incoming packets are dropped when the buffer is full, so its size limits how much data a
+// windowed write may have in flight.
+#if CIRCUITPY_FULL_BUILD
+#define PACKET_BUFFER_SIZE (4096)
+#else
 // 2 * 10 ringbuf packets, 512 for a disk sector and 12 for the file transfer write header.
 #define PACKET_BUFFER_SIZE (2 * 10 + 512 + 12)
+#endif
 // uint32_t so its aligned
 static uint32_t _buffer[PACKET_BUFFER_SIZE / 4 + 1];
 static uint32_t _outgoing1[BLEIO_PACKET_BUFFER_MAX_PACKET_SIZE / 4];
@@ -71,7 +77,7 @@ void supervisor_start_bluetooth_file_transfer(void) {
         NULL,                                       // no initial value
         NULL); // no description
 
-    uint32_t version = 4;
+    uint32_t version = 5;
     mp_buffer_info_t bufinfo;
     bufinfo.buf = &version;
     bufinfo.len = sizeof(version);
@@ -130,11 +136,43 @@ static uint64_t truncate_time(uint64_t input_time, DWORD *fattime) {
 // Used by read and write.
 static FIL active_file;
 static fs_user_mount_t *active_mount;
-static uint8_t _process_read(const uint8_t *raw_buf, size_t command_len) {
+// Set by READ and WRITE when the central asked for a windowed transfer.
+static bool _windowed;
+// The next file offset to send for reads and the last acknowledged offset for writes.
+static uint32_t _transfer_offset;
+
+// Sends a READ_DATA header followed by size bytes of active_file starting at offset. buf is
+// the command buffer, which is free to reuse once the command has been decoded.
+static uint32_t _send_read_data(uint8_t *buf, uint32_t offset, uint32_t size, uint32_t total_length) {
+    struct read_data response;
+    response.command = READ_DATA;
+    response.status = STATUS_OK;
+    response.chunk_offset = offset;
+    response.total_length = total_length;
+    response.data_size = size;
+    common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct read_data), NULL, 0);
+    f_lseek(&active_file, offset);
+    // Write out the chunk contents. We can do this in large pieces because PacketBuffer
+    // will split them into packets of its own.
+    uint32_t sent = 0;
+    while (sent < size) {
+        UINT quantity_read;
+        FRESULT result = f_read(&active_file, buf, MIN(size - sent, COMMAND_SIZE), &quantity_read);
+        if (quantity_read == 0 || result != FR_OK) {
+            // TODO: If we can't read everything, then the file must have been shortened. Maybe we
+            // should return 0s to pad it out.
+            break;
+        }
+        common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, buf, quantity_read, NULL, 0);
+        sent += quantity_read;
+    }
+    return sent;
+}
+
+static uint8_t _process_read(uint8_t *raw_buf, size_t command_len) {
     struct read_command *command = (struct read_command *)raw_buf;
     size_t header_size = sizeof(struct read_command);
     size_t response_size = sizeof(struct read_data);
-    uint8_t data_buffer[response_size];
     struct read_data response;
     response.command = READ_DATA;
     response.status = STATUS_OK;
@@ -167,66 +205,32 @@ static uint8_t _process_read(const uint8_t *raw_buf, size_t command_len) {
         common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, response_size, NULL, 0);
         return ANY_COMMAND;
     }
+    _windowed = (command->flags & TRANSFER_WINDOWED) != 0;
     uint32_t total_length = f_size(&active_file);
-    // Write out the response header.
-    uint32_t offset = command->chunk_offset;
-    uint32_t chunk_size = command->chunk_size;
-    chunk_size = MIN(chunk_size, total_length - offset);
-    response.chunk_offset = offset;
-    response.total_length = total_length;
-    response.data_size = chunk_size;
-    common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, response_size, NULL, 0);
-    f_lseek(&active_file, offset);
-    // Write out the chunk contents. We can do this in small pieces because PacketBuffer
-    // will assemble them into larger packets of its own.
-    size_t chunk_end = offset + chunk_size;
-    while (offset < chunk_end) {
-        size_t quantity_read;
-        size_t read_amount = MIN(response_size, chunk_end - offset);
-        f_read(&active_file, data_buffer, read_amount, &quantity_read);
-        offset += quantity_read;
-        // TODO: Do something if the read fails
-        common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, data_buffer, quantity_read, NULL, 0);
-    }
-    if (offset >= total_length) {
+    uint32_t offset = MIN(command->chunk_offset, total_length);
+    uint32_t chunk_size = MIN(command->chunk_size, total_length - offset);
+    _transfer_offset = offset + _send_read_data(raw_buf, offset, chunk_size, total_length);
+    if (_transfer_offset >= total_length) {
         f_close(&active_file);
         return ANY_COMMAND;
     }
     return READ_PACING;
 }
 
-static uint8_t _process_read_pacing(const uint8_t *raw_buf, size_t command_len) {
+static uint8_t _process_read_pacing(uint8_t *raw_buf, size_t command_len) {
     struct read_pacing *command = (struct read_pacing *)raw_buf;
-    struct read_data response;
-    response.command = READ_DATA;
-    response.status = STATUS_OK;
-    size_t response_size = sizeof(struct read_data);
-
     uint32_t total_length = f_size(&active_file);
-    // Write out the response header.
-    uint32_t chunk_size = MIN(command->chunk_size, total_length - command->chunk_offset);
-    response.chunk_offset = command->chunk_offset;
-    response.total_length = total_length;
-    response.data_size = chunk_size;
-    common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, response_size, NULL, 0);
-    f_lseek(&active_file, command->chunk_offset);
-    // Write out the chunk contents. We can do this in small pieces because PacketBuffer
-    // will assemble them into larger packets of its own.
-    size_t chunk_offset = 0;
-    uint8_t data[20];
-    while (chunk_offset < chunk_size) {
-        size_t quantity_read;
-        size_t read_size = MIN(chunk_size - chunk_offset, sizeof(data));
-        FRESULT result = f_read(&active_file, &data, read_size, &quantity_read);
-        if (quantity_read == 0 || result != FR_OK) {
-            // TODO: If we can't read everything, then the file must have been shortened. Maybe we
-            // should return 0s to pad it out.
-            break;
+    uint32_t offset = MIN(command->chunk_offset, total_length);
+    uint32_t end = offset + MIN(command->chunk_size, total_length - offset);
+    if (_windowed) {
+        // Everything before chunk_offset has arrived. Only send what the window adds.
+        if (end <= _transfer_offset) {
+            return READ_PACING;
         }
-        common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&data, quantity_read, NULL, 0);
-        chunk_offset += quantity_read;
+        offset = _transfer_offset;
     }
-    if ((chunk_offset + chunk_size) >= total_length) {
+    _transfer_offset = offset + _send_read_data(raw_buf, offset, end - offset, total_length);
+    if (_transfer_offset >= total_length) {
         f_close(&active_file);
         return ANY_COMMAND;
     }
@@ -236,6 +240,38 @@ static uint8_t _process_read_pacing(const uint8_t *raw_buf, size_t command_len)
 // Used by write and write data to know when the write is complete.
 static size_t total_write_length;
 static uint64_t _truncated_time;
+// How much data a windowed write may have in flight past the last acknowledgement.
+static size_t _write_window;
+// True from a successful WRITE open until the file is closed and the lock released.
+static bool _write_open;
+// Where the next WRITE_DATA of a windowed write must start: everything before it is written.
+static uint32_t _write_expected_offset;
+// The offset of the last WRITE_DATA received, in order or not.
+static uint32_t _write_last_offset;
+// True from a gap in the WRITE_DATA offsets until the central resends from the gap.
+static bool _write_gap;
+
+// Closes the file of a write and releases what _process_write took for it. Does nothing
+// when no write is open, such as for a WRITE_DATA without a WRITE.
+static void _finish_write(void) {
+    if (!_write_open) {
+        return;
+    }
+    f_close(&active_file);
+    override_fattime(0);
+    filesystem_unlock(active_mount);
+    _write_open = false;
+}
+
+// Incoming packets are dropped when the packet buffer is full so everything in flight must
+// fit in it. Assume each WRITE_DATA fills one packet and count its length and header.
+static size_t _compute_write_window(void) {
+    mp_int_t packet_size = common_hal_bleio_packet_buffer_get_incoming_packet_length(&_transfer_packet_buffer);
+    if (packet_size <= (mp_int_t)sizeof(struct write_data)) {
+        return 512;
+    }
+    return (PACKET_BUFFER_SIZE / (packet_size + sizeof(uint16_t))) * (packet_size - sizeof(struct write_data));
+}
 
 static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
     struct write_command *command = (struct write_command *)raw_buf;
@@ -243,6 +279,8 @@ static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
     struct write_pacing response;
     response.command = WRITE_PACING;
     response.status = STATUS_OK;
+    response.flags = 0;
+    response.reserved = 0;
     if (command->path_length > (COMMAND_SIZE - header_size - 1)) { // -1 for the null we'll write
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
@@ -254,6 +292,7 @@ static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
         return THIS_COMMAND;
     }
     total_write_length = command->total_length;
+    _windowed = (command->flags & TRANSFER_WINDOWED) != 0;
 
     char *full_path = (char *)command->path;
     full_path[command->path_length] = '\0';
@@ -283,18 +322,27 @@ static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
         override_fattime(0);
         return ANY_COMMAND;
     }
+    _write_open = true;
     // Write out the pacing response.
 
-    // Align the next chunk to a sector boundary.
     uint32_t offset = command->offset;
-    size_t chunk_size = MIN(total_write_length - offset, 512 - (offset % 512));
+    _transfer_offset = offset;
+    size_t chunk_size;
+    if (_windowed) {
+        _write_window = _compute_write_window();
+        _write_expected_offset = offset;
+        _write_last_offset = offset;
+        _write_gap = false;
+        chunk_size = MIN(total_write_length - offset, _write_window);
+    } else {
+        // Align the next chunk to a sector boundary.
+        chunk_size = MIN(total_write_length - offset, 512 - (offset % 512));
+    }
     // Special case when truncating the file. (Deleting stuff off the end.)
     if (chunk_size == 0) {
         f_lseek(&active_file, offset);
         f_truncate(&active_file);
-        f_close(&active_file);
-        override_fattime(0);
-        filesystem_unlock(active_mount);
+        _finish_write();
     }
     response.offset = offset;
     response.free_space = chunk_size;
@@ -315,12 +363,13 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
     struct write_pacing response;
     response.command = WRITE_PACING;
     response.status = STATUS_OK;
+    response.flags = 0;
+    response.reserved = 0;
     if (command->data_size > (COMMAND_SIZE - header_size - 1)) { // -1 for the null we'll write
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
         common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
-        filesystem_unlock(active_mount);
-        override_fattime(0);
+        _finish_write();
         return ANY_COMMAND;
     }
     // We need to receive another packet to have the full path.
@@ -328,6 +377,28 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
         return THIS_COMMAND;
     }
     uint32_t offset = command->offset;
+    if (_windowed) {
+        bool rewound = offset <= _write_last_offset;
+        _write_last_offset = offset;
+        if (offset != _write_expected_offset) {
+            // A packet was dropped. Writing this chunk would leave a hole in the file, so drop
+            // it and ask the central to resend from the end of the written data. The chunks
+            // that were already in flight behind it follow in order and are dropped quietly
+            // until the central starts over.
+            if (_write_gap && !rewound) {
+                return WRITE_DATA;
+            }
+            _write_gap = true;
+            _transfer_offset = _write_expected_offset;
+            response.flags = TRANSFER_RESEND;
+            response.offset = _transfer_offset;
+            response.free_space = MIN(total_write_length - _transfer_offset, _write_window);
+            response.truncated_time = _truncated_time;
+            common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
+            return WRITE_DATA;
+        }
+        _write_gap = false;
+    }
     f_lseek(&active_file, offset);
     UINT actual;
     f_write(&active_file, command->data, command->data_size, &actual);
@@ -335,22 +406,30 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
         common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
-        filesystem_unlock(active_mount);
-        override_fattime(0);
+        _finish_write();
         return ANY_COMMAND;
     }
     offset += command->data_size;
-    // Align the next chunk to a sector boundary.
-    size_t chunk_size = MIN(total_write_length - offset, 512);
+    size_t chunk_size;
+    if (_windowed) {
+        _write_expected_offset = offset;
+        // Acknowledge in batches so that the central doesn't wait on every WRITE_DATA.
+        if (offset < total_write_length && offset - _transfer_offset < _write_window / 2) {
+            return WRITE_DATA;
+        }
+        _transfer_offset = offset;
+        chunk_size = MIN(total_write_length - offset, _write_window);
+    } else {
+        // Align the next chunk to a sector boundary.
+        chunk_size = MIN(total_write_length - offset, 512);
+    }
     response.offset = offset;
     response.free_space = chunk_size;
     response.truncated_time = _truncated_time;
     common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
     if (total_write_length == offset) {
         f_truncate(&active_file);
-        f_close(&active_file);
-        override_fattime(0);
-        filesystem_unlock(active_mount);
+        _finish_write();
         // Don't reload until everything is written out of the packet buffer.
         common_hal_bleio_packet_buffer_flush(&_transfer_packet_buffer);
         return ANY_COMMAND;
@@ -631,7 +710,10 @@ void supervisor_bluetooth_file_transfer_background(void) {
                 next_command = _process_read(current_command, current_offset);
                 break;
             case READ_PACING:
-                next_command = _process_read_pacing(current_command, current_offset);
+                // Windowed reads may still be acknowledging data after all of it was sent.
+                if (next_command == READ_PACING) {
+                    next_command = _process_read_pacing(current_command, current_offset);
+                }
                 break;
             case WRITE:
                 next_command = _process_write(current_command, current_offset);
@@ -672,8 +754,16 @@ void supervisor_bluetooth_file_transfer_background(void) {
 }
 
 void supervisor_bluetooth_file_transfer_disconnected(void) {
+    // Closing keeps everything written so far. The central can resume by sending WRITE again
+    // with the last offset it had acknowledged.
+    // next_command is THIS_COMMAND while a WRITE_DATA is only partly received, so it
+    // can't tell whether a write is open.
+    if (_write_open) {
+        _finish_write();
+    } else {
+        f_close(&active_file);
+    }
     next_command = ANY_COMMAND;
     current_offset = 0;
-    f_close(&active_file);
     autoreload_resume(AUTORELOAD_SUSPEND_BLE);
 }
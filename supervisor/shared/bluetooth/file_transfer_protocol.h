@@ -16,11 +16,36 @@
 // an array of the struct.) So, be careful that types added are aligned. Otherwise,
 // the compiler may generate more code than necessary.
 
+// Version 5 adds windowed reads and writes. They are requested by setting
+// TRANSFER_WINDOWED in the flags of a READ or WRITE command. Older centrals send 0 there
+// and get the original one chunk per round trip behavior.
+//
+// Windowed reads: chunk_size in READ is a window rather than a chunk. The peripheral sends
+// READ_DATA until it reaches chunk_offset + chunk_size and then keeps the file open.
+// Each READ_PACING acknowledges everything before its chunk_offset and grants chunk_size
+// bytes past it. The peripheral only sends what the new window adds beyond what it has
+// already sent, so the central should send READ_PACING before the window runs out to keep
+// data flowing. No READ_PACING should be sent once a window reaches the end of the file.
+//
+// Windowed writes: the free_space of each WRITE_PACING is a window past its offset. The
+// central may send any number of WRITE_DATA commands, in order, until it has sent offset +
+// free_space bytes. The window assumes that each WRITE_DATA fills one packet. The peripheral acknowledges with WRITE_PACING after every half window
+// or so instead of after every WRITE_DATA. The final WRITE_PACING has a free_space of 0.
+// A WRITE_DATA that doesn't start where the written data ends, because a packet was lost,
+// is dropped. The peripheral then sends a WRITE_PACING with TRANSFER_RESEND set in its flags
+// and the end of the written data as its offset. The central should send again from there.
+// WRITE_DATA that was already in flight is dropped without another WRITE_PACING.
+//
+// Acknowledged data is kept when the connection drops. The central can resume by sending
+// READ or WRITE again with the offset it last had acknowledged.
+#define TRANSFER_WINDOWED 0x01
+#define TRANSFER_RESEND 0x02
+
 // 0x00 - 0x0f are never used by the protocol as a command
 #define READ 0x10
 struct read_command {
     uint8_t command;
-    uint8_t reserved;
+    uint8_t flags;
     uint16_t path_length;
     uint32_t chunk_offset;
     uint32_t chunk_size;
@@ -50,7 +75,7 @@ struct read_pacing {
 #define WRITE 0x20
 struct write_command {
     uint8_t command;
-    uint8_t reserved;
+    uint8_t flags;
     uint16_t path_length;
     uint32_t offset;
     uint64_t modification_time;
@@ -62,7 +87,8 @@ struct write_command {
 struct write_pacing {
     uint8_t command;
     uint8_t status;
-    uint16_t reserved;
+    uint8_t flags;
+    uint8_t reserved;
     uint32_t offset;
     uint64_t truncated_time;
     uint32_t free_space;
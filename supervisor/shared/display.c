@@ -93,7 +93,8 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
         }
     }
     if (!tilegrid_tiles) {
-        tilegrid_tiles = port_malloc(total_tiles, false);
+        // Fonts with more than 256 glyphs need two bytes per tile.
+        tilegrid_tiles = port_malloc(total_tiles * (scroll_area->wide_tiles ? 2 : 1), false);
         reset_tiles = true;
         if (!tilegrid_tiles) {
             return;
@@ -136,7 +137,7 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
         // Align the scroll area to the bottom so that the newest line isn't cutoff. The top line
         // may be clipped by the status bar and that's ok.
         scroll_area->y = height_px - scroll_area->pixel_height;
-        scroll_area->tiles = tilegrid_tiles + width_in_tiles;
+        scroll_area->tiles = tilegrid_tiles + width_in_tiles * (scroll_area->wide_tiles ? 2 : 1);
         scroll_area->full_change = true;
 
         common_hal_terminalio_terminal_construct(&supervisor_terminal, scroll_area, &supervisor_terminal_font, status_bar);
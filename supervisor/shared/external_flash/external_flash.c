@@ -7,11 +7,17 @@
 
 #include <stdint.h>
 #include <string.h>
+#if SIM_FLASH_FILESYSTEM
+#include "supervisor/shared/external_flash/sim_flash.h"
+#else
 #include "genhdr/devices.h"
+#endif
 #include "supervisor/flash.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/spi_flash_api.h"
 #include "supervisor/shared/external_flash/common_commands.h"
+#include "supervisor/shared/tick.h"
 #include "extmod/vfs.h"
 #include "extmod/vfs_fat.h"
 #include "py/misc.h"
@@ -22,24 +28,59 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
-
+#if SIM_FLASH_FILESYSTEM
+static const external_flash_device possible_devices[] = {SIM_FLASH_DEVICE};
+#else
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
+#endif
 #define EXTERNAL_FLASH_DEVICE_COUNT MP_ARRAY_SIZE(possible_devices)
 
 static const external_flash_device *flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
-// cache.
-static uint32_t dirty_mask;
-
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
 #define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+#define ALL_BLOCKS_MASK ((uint32_t)((1ULL << BLOCKS_PER_SECTOR) - 1))
+
+// One erase sector whose writes haven't made it to the flash yet.
+typedef struct {
+    // The cached sector, or NO_SECTOR_LOADED.
+    uint32_t sector;
+    // Track which blocks (up to 32) in the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // Value of cache_clock when the sector was last written, for LRU eviction.
+    uint32_t last_used;
+    // Table of pointers to each cached page. Should be zero'd after
+    // allocation. NULL when the sector is staged in the scratch sector at the
+    // end of the flash instead, which at most one entry does at a time.
+    uint8_t **table;
+} flash_cache_t;
+
+// Sectors are written back when they are evicted or the filesystem is
+// flushed, so FAT and directory updates that bounce between a few sectors
+// don't cost an erase each.
+static flash_cache_t flash_cache[SPI_FLASH_CACHE_SECTORS];
+static uint32_t cache_clock;
+
+// When enabled, small sequential reads, like code reading a file a block at a
+// time, fetch the blocks that follow along with them so the next reads are
+// served from ram.
+#if SPI_FLASH_READ_AHEAD_BLOCKS > 0
+#define READ_AHEAD_SIZE (SPI_FLASH_READ_AHEAD_BLOCKS * FILESYSTEM_BLOCK_SIZE)
+#endif
+static uint8_t *read_ahead_buffer;
+static uint32_t read_ahead_block;
+static uint32_t read_ahead_count;
+// The block just after the last read, to detect sequential reads.
+static uint32_t next_read_block;
+
+// When the flash was last read or written, so that flushes only give ram back
+// once it has been idle for SPI_FLASH_RELEASE_IDLE_MS.
+static uint32_t last_used_ms;
+// Whether we hold a tick to keep periodic flushes coming until that ram is
+// released.
+static bool holding_tick;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -135,7 +176,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -277,9 +318,16 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
-    flash_cache_table = NULL;
+    for (size_t i = 0; i < SPI_FLASH_CACHE_SECTORS; i++) {
+        flash_cache[i].sector = NO_SECTOR_LOADED;
+        flash_cache[i].dirty_mask = 0;
+        flash_cache[i].table = NULL;
+    }
+    cache_clock = 0;
+    read_ahead_buffer = NULL;
+    read_ahead_count = 0;
+    next_read_block = 0;
+    holding_tick = false;
 }
 
 // The size of each individual block.
@@ -297,20 +345,21 @@ uint32_t supervisor_flash_get_block_count(void) {
     return (flash_device->total_size - SPI_FLASH_ERASE_SIZE) / FILESYSTEM_BLOCK_SIZE;
 }
 
+static uint32_t scratch_sector_address(void) {
+    return flash_device->total_size - SPI_FLASH_ERASE_SIZE;
+}
+
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
-static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        return true;
-    }
+static bool flush_scratch_flash(flash_cache_t *cache) {
     // First, copy out any blocks that we haven't touched from the sector we've
     // cached.
     bool copy_to_scratch_ok = true;
-    uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
+    uint32_t scratch_sector = scratch_sector_address();
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((cache->dirty_mask & (1 << i)) == 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(cache->sector + i * FILESYSTEM_BLOCK_SIZE,
                 scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -320,44 +369,45 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cache->sector);
     // Finally, copy the new version into it.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-            current_sector + i * FILESYSTEM_BLOCK_SIZE);
+            cache->sector + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
+// Free all entries in the partially or completely filled table of the cache,
+// and then free the table itself.
+static void release_ram_cache(flash_cache_t *cache) {
+    if (cache->table == NULL) {
         return;
     }
 
     for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
         // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
+        if (cache->table[i] == NULL) {
             break;
         }
-        port_free(flash_cache_table[i]);
+        port_free(cache->table[i]);
     }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
+    port_free(cache->table);
+    cache->table = NULL;
 }
 
 // Attempts to allocate a new set of page buffers for caching a full sector in
 // ram. Each page is allocated separately so that the GC doesn't need to provide
 // one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
+static bool allocate_ram_cache(flash_cache_t *cache) {
+    cache->table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
+    if (cache->table == NULL) {
         // Not enough space even for the cache table.
         return false;
     }
 
     // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
+    memset(cache->table, 0, FLASH_CACHE_TABLE_SIZE);
 
     bool success = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
@@ -367,85 +417,136 @@ static bool allocate_ram_cache(void) {
                 success = false;
                 break;
             }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
+            cache->table[i * PAGES_PER_BLOCK + j] = page_cache;
         }
     }
 
     // We couldn't allocate enough so give back what we got.
     if (!success) {
-        release_ram_cache();
+        release_ram_cache(cache);
     }
     return success;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
-        return true;
-    }
-
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
+// Write the blocks of the cached sector from ram onto the flash.
+static bool flush_ram_cache(flash_cache_t *cache) {
+    // If every block we have cached still reads as erased on the flash, the
+    // rest of the sector can stay where it is and we only program the new
+    // blocks.
+    bool in_place = true;
+    for (size_t i = 0; i < BLOCKS_PER_SECTOR && in_place; i++) {
+        if ((cache->dirty_mask & (1 << i)) != 0) {
+            in_place = page_erased(cache->sector + i * FILESYSTEM_BLOCK_SIZE);
         }
-        return true;
     }
-    // First, copy out any blocks that we haven't touched from the sector
-    // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
-    bool copy_to_ram_ok = true;
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
-            for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
+    uint32_t write_mask = cache->dirty_mask;
+    if (!in_place) {
+        // First, copy out any blocks that we haven't touched from the sector
+        // we've cached. If we don't do this we'll erase the data during the
+        // sector erase below.
+        bool copy_to_ram_ok = true;
+        for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+            if ((cache->dirty_mask & (1 << i)) == 0) {
+                for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
+                    copy_to_ram_ok = read_flash(
+                        cache->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                        cache->table[i * PAGES_PER_BLOCK + j],
+                        SPI_FLASH_PAGE_SIZE);
+                    if (!copy_to_ram_ok) {
+                        break;
+                    }
                 }
             }
+            if (!copy_to_ram_ok) {
+                break;
+            }
         }
+
         if (!copy_to_ram_ok) {
-            break;
+            return false;
         }
+        // Second, erase the current sector.
+        erase_sector(cache->sector);
+        write_mask = ALL_BLOCKS_MASK;
     }
-
-    if (!copy_to_ram_ok) {
-        return false;
-    }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
     // Lastly, write all the data in ram that we've cached.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if ((write_mask & (1 << i)) == 0) {
+            continue;
+        }
         for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
+            write_flash(cache->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                cache->table[i * PAGES_PER_BLOCK + j],
                 SPI_FLASH_PAGE_SIZE);
         }
     }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
-    }
     return true;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
+// Write back one cached sector, delegating to the correct flush method
+// depending on where it is cached. The ram stays allocated for reuse.
+static bool flush_cache(flash_cache_t *cache) {
+    if (cache->sector == NO_SECTOR_LOADED) {
+        return true;
+    }
+    bool ok;
+    if (cache->table == NULL) {
+        ok = flush_scratch_flash(cache);
+    } else {
+        ok = flush_ram_cache(cache);
+    }
+    cache->sector = NO_SECTOR_LOADED;
+    cache->dirty_mask = 0;
+    // The read ahead buffer may hold what the flash had before the flush.
+    read_ahead_count = 0;
+    return ok;
+}
+
+// Flushes every cached sector and frees the ram caches and the read ahead
+// buffer. If keep_cache is true, the ram of one sector is kept for the next
+// write, as when only one sector was ever cached. The rest is also kept while
+// the flash is in use, and goes back to the heap on the first flush after it
+// has been idle for SPI_FLASH_RELEASE_IDLE_MS.
 // TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
-    // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+    bool keep_all = keep_cache &&
+        supervisor_ticks_ms32() - last_used_ms < SPI_FLASH_RELEASE_IDLE_MS;
+    bool keep_one = keep_cache;
+    bool kept_more = false;
+    for (size_t i = 0; i < SPI_FLASH_CACHE_SECTORS; i++) {
+        flush_cache(&flash_cache[i]);
+        if (flash_cache[i].table == NULL) {
+            continue;
+        }
+        if (keep_one) {
+            keep_one = false;
+        } else if (keep_all) {
+            kept_more = true;
+        } else {
+            release_ram_cache(&flash_cache[i]);
+        }
+    }
+    if (read_ahead_buffer != NULL) {
+        if (keep_all) {
+            kept_more = true;
+        } else {
+            port_free(read_ahead_buffer);
+            read_ahead_buffer = NULL;
+            read_ahead_count = 0;
+        }
+    }
+    // Periodic flushes only happen while ticks are on, so keep them on until
+    // the extra ram has been released.
+    if (kept_more && !holding_tick) {
+        supervisor_enable_tick();
+        holding_tick = true;
+    } else if (!kept_more && holding_tick) {
+        supervisor_disable_tick();
+        holding_tick = false;
     }
-    current_sector = NO_SECTOR_LOADED;
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -459,6 +560,53 @@ void supervisor_flash_release_cache(void) {
     spi_flash_flush_keep_cache(false);
 }
 
+static flash_cache_t *find_cache(uint32_t sector) {
+    for (size_t i = 0; i < SPI_FLASH_CACHE_SECTORS; i++) {
+        if (flash_cache[i].sector == sector) {
+            return &flash_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Picks the cache entry to hold a newly written sector. Unused entries are
+// used first as long as there is ram for them. Otherwise the least recently
+// written sector is flushed to make room. When nothing is cached and there is
+// no ram at all, the sector is staged in the scratch sector of the flash.
+static flash_cache_t *claim_cache(uint32_t sector) {
+    flash_cache_t *unused = NULL;
+    flash_cache_t *oldest = NULL;
+    for (size_t i = 0; i < SPI_FLASH_CACHE_SECTORS; i++) {
+        flash_cache_t *cache = &flash_cache[i];
+        if (cache->sector == NO_SECTOR_LOADED) {
+            // Prefer an entry that already has its ram.
+            if (unused == NULL || (unused->table == NULL && cache->table != NULL)) {
+                unused = cache;
+            }
+        } else if (oldest == NULL ||
+                   cache_clock - cache->last_used > cache_clock - oldest->last_used) {
+            oldest = cache;
+        }
+    }
+
+    flash_cache_t *claimed;
+    if (unused != NULL && (unused->table != NULL || allocate_ram_cache(unused))) {
+        claimed = unused;
+    } else if (oldest != NULL) {
+        flush_cache(oldest);
+        claimed = oldest;
+    } else {
+        claimed = unused;
+    }
+    if (claimed->table == NULL) {
+        erase_sector(scratch_sector_address());
+        wait_for_flash_ready();
+    }
+    claimed->sector = sector;
+    claimed->dirty_mask = 0;
+    return claimed;
+}
+
 static int32_t convert_block_to_flash_addr(uint32_t block) {
     if (0 <= block && block < supervisor_flash_get_block_count()) {
         // a block in partition 1
@@ -468,32 +616,66 @@ static int32_t convert_block_to_flash_addr(uint32_t block) {
     return -1;
 }
 
-static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
-    int32_t address = convert_block_to_flash_addr(block);
-    if (address == -1) {
-        // bad block number
-        return false;
-    }
-
+// Returns the cache holding the latest version of the block at address, or
+// NULL if the flash has it.
+static flash_cache_t *cache_for_block(uint32_t address) {
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
-    uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
-            for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-                memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                    SPI_FLASH_PAGE_SIZE);
+    flash_cache_t *cache = find_cache(this_sector);
+    if (cache != NULL && (cache->dirty_mask & (1 << block_index)) != 0) {
+        return cache;
+    }
+    return NULL;
+}
+
+static bool read_cached_block(flash_cache_t *cache, uint8_t *dest, uint32_t address) {
+    size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+    if (cache->table != NULL) {
+        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
+            memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
+                cache->table[block_index * PAGES_PER_BLOCK + i],
+                SPI_FLASH_PAGE_SIZE);
+        }
+        return true;
+    }
+    uint32_t scratch_address = scratch_sector_address() + block_index * FILESYSTEM_BLOCK_SIZE;
+    return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
+}
+
+// Copies the block from the read ahead buffer into dest. When refill is true
+// and the block isn't buffered, the buffer is refilled starting at the block.
+// Returns false if the block has to be read from the flash instead.
+static bool read_ahead(uint8_t *dest, uint32_t block, bool refill) {
+    if (block - read_ahead_block >= read_ahead_count) {
+        #if SPI_FLASH_READ_AHEAD_BLOCKS > 0
+        if (!refill) {
+            return false;
+        }
+        if (read_ahead_buffer == NULL) {
+            read_ahead_buffer = port_malloc(READ_AHEAD_SIZE, false);
+            if (read_ahead_buffer == NULL) {
+                return false;
             }
-            return true;
-        } else {
-            uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-            return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
         }
+        #else
+        return false;
+        #endif
+        uint32_t count = supervisor_flash_get_block_count() - block;
+        if (count > SPI_FLASH_READ_AHEAD_BLOCKS) {
+            count = SPI_FLASH_READ_AHEAD_BLOCKS;
+        }
+        if (!read_flash(block * FILESYSTEM_BLOCK_SIZE, read_ahead_buffer,
+            count * FILESYSTEM_BLOCK_SIZE)) {
+            read_ahead_count = 0;
+            return false;
+        }
+        read_ahead_block = block;
+        read_ahead_count = count;
     }
-    return read_flash(address, dest, FILESYSTEM_BLOCK_SIZE);
+    memcpy(dest, read_ahead_buffer + (block - read_ahead_block) * FILESYSTEM_BLOCK_SIZE,
+        FILESYSTEM_BLOCK_SIZE);
+    return true;
 }
 
 static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
@@ -509,49 +691,87 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    // The read ahead copy of the block is stale now.
+    if (block - read_ahead_block < read_ahead_count) {
+        read_ahead_count = 0;
+    }
+    flash_cache_t *cache = find_cache(this_sector);
+    // A block staged in the scratch sector can't be written again without an
+    // erase, so flush it first. Blocks cached in ram are simply replaced.
+    if (cache != NULL && cache->table == NULL && (mask & cache->dirty_mask) > 0) {
+        flush_cache(cache);
+        cache = NULL;
+    }
+    if (cache == NULL) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
-        }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        cache = claim_cache(this_sector);
     }
-    dirty_mask |= mask;
+    cache->dirty_mask |= mask;
+    cache->last_used = ++cache_clock;
     // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
+    if (cache->table != NULL) {
         for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+            memcpy(cache->table[block_index * PAGES_PER_BLOCK + i],
                 data + i * SPI_FLASH_PAGE_SIZE,
                 SPI_FLASH_PAGE_SIZE);
         }
         return true;
     } else {
-        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+        uint32_t scratch_address = scratch_sector_address() + block_index * FILESYSTEM_BLOCK_SIZE;
         return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
     }
 }
 
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+    uint32_t block_count = supervisor_flash_get_block_count();
+    if (block_num >= block_count || num_blocks > block_count - block_num) {
+        return 1; // error
+    }
+    #if SPI_FLASH_READ_AHEAD_BLOCKS > 0
+    bool use_read_ahead = block_num == next_read_block && num_blocks < SPI_FLASH_READ_AHEAD_BLOCKS;
+    #else
+    bool use_read_ahead = false;
+    #endif
+    next_read_block = block_num + num_blocks;
+    last_used_ms = supervisor_ticks_ms32();
+
+    uint32_t i = 0;
+    while (i < num_blocks) {
+        uint32_t address = (block_num + i) * FILESYSTEM_BLOCK_SIZE;
+        uint8_t *block_dest = dest + i * FILESYSTEM_BLOCK_SIZE;
+        // Blocks waiting to be written back are newer than the flash.
+        flash_cache_t *cache = cache_for_block(address);
+        if (cache != NULL) {
+            if (!read_cached_block(cache, block_dest, address)) {
+                return 1; // error
+            }
+            i++;
+            continue;
+        }
+        if (read_ahead(block_dest, block_num + i, use_read_ahead)) {
+            i++;
+            continue;
+        }
+        // Read the whole run of blocks that live on the flash at once.
+        uint32_t run = 1;
+        while (i + run < num_blocks &&
+               cache_for_block(address + run * FILESYSTEM_BLOCK_SIZE) == NULL) {
+            run++;
+        }
+        if (!read_flash(address, block_dest, run * FILESYSTEM_BLOCK_SIZE)) {
             return 1; // error
         }
+        i += run;
     }
     return 0; // success
 }
 
 mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    last_used_ms = supervisor_ticks_ms32();
     for (size_t i = 0; i < num_blocks; i++) {
         if (!external_flash_write_block(src + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
             return 1; // error
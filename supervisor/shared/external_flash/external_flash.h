@@ -24,6 +24,35 @@
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
 
+// How many erase sectors can wait in ram to be written back. Each one takes
+// SPI_FLASH_ERASE_SIZE bytes of ram once it's used, and fewer are used when
+// the allocation fails. Copying files touches at least the FAT, a directory
+// and the file data at once, but ports with less than 64kB of ram (such as the
+// SAMD21) can't spare more than the one sector they always cached.
+#ifndef SPI_FLASH_CACHE_SECTORS
+#if defined(RAM_SIZE) && RAM_SIZE < (64 * 1024)
+#define SPI_FLASH_CACHE_SECTORS (1)
+#else
+#define SPI_FLASH_CACHE_SECTORS (4)
+#endif
+#endif
+
+// How many blocks small sequential reads fetch at once. Reads of this many
+// blocks or more bypass the buffer and go to the flash in one read. 0, the
+// default, turns read ahead off: USB hosts read CFG_TUD_MSC_EP_BUFSIZE bytes
+// at a time, which is already 8 blocks on ports with the ram for a buffer, and
+// a single block on ports that can't spare one.
+#ifndef SPI_FLASH_READ_AHEAD_BLOCKS
+#define SPI_FLASH_READ_AHEAD_BLOCKS (0)
+#endif
+
+// How long the flash has to go unused before a periodic flush gives the ram of
+// all but one cached sector, and the read ahead buffer, back to the heap. Until
+// then it is kept so that flushes during a copy don't free and reallocate it.
+#ifndef SPI_FLASH_RELEASE_IDLE_MS
+#define SPI_FLASH_RELEASE_IDLE_MS (5000)
+#endif
+
 void supervisor_external_flash_flush(void);
 
 // Configure anything that needs to get set up before the external flash
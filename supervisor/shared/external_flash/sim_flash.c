@@ -0,0 +1,129 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// A ram backed stand-in for an SPI NOR flash chip, so that external_flash.c
+// can be run and measured without hardware. Like a real chip, programming can
+// only clear bits, erasing sets a whole sector back to 0xff and both need the
+// write enable latch to be set first.
+
+#include "supervisor/spi_flash_api.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "supervisor/shared/external_flash/common_commands.h"
+#include "supervisor/shared/external_flash/external_flash.h"
+#include "supervisor/shared/external_flash/sim_flash.h"
+
+static const external_flash_device sim_device = SIM_FLASH_DEVICE;
+
+static uint8_t sim_flash[SIM_FLASH_SIZE];
+static bool sim_flash_erased = false;
+static bool write_enable_latch;
+
+sim_flash_stats_t sim_flash_stats;
+
+void sim_flash_reset_stats(void) {
+    memset(&sim_flash_stats, 0, sizeof(sim_flash_stats));
+}
+
+static bool in_range(uint32_t address, uint32_t length) {
+    return address < SIM_FLASH_SIZE && length <= SIM_FLASH_SIZE - address;
+}
+
+bool spi_flash_command(uint8_t command) {
+    if (command == CMD_ENABLE_WRITE) {
+        write_enable_latch = true;
+    } else if (command == CMD_DISABLE_WRITE) {
+        write_enable_latch = false;
+    }
+    return true;
+}
+
+bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length) {
+    memset(response, 0, length);
+    switch (command) {
+        case CMD_READ_JEDEC_ID:
+            if (length >= 3) {
+                response[0] = sim_device.manufacturer_id;
+                response[1] = sim_device.memory_type;
+                response[2] = sim_device.capacity;
+            }
+            break;
+        case CMD_READ_STATUS:
+            // Operations complete immediately so only the write enable latch
+            // is ever set.
+            if (length >= 1 && write_enable_latch) {
+                response[0] = 0x02;
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length) {
+    if (!write_enable_latch) {
+        return false;
+    }
+    // Writing the status registers has no effect beyond clearing the latch.
+    write_enable_latch = false;
+    return true;
+}
+
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    if (command != CMD_SECTOR_ERASE || !write_enable_latch) {
+        return false;
+    }
+    write_enable_latch = false;
+    address &= ~(SPI_FLASH_ERASE_SIZE - 1);
+    if (!in_range(address, SPI_FLASH_ERASE_SIZE)) {
+        return false;
+    }
+    memset(sim_flash + address, 0xff, SPI_FLASH_ERASE_SIZE);
+    sim_flash_stats.sector_erases++;
+    return true;
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    if (!write_enable_latch) {
+        return false;
+    }
+    write_enable_latch = false;
+    // A page program can't cross into the next page.
+    uint32_t page_offset = address % SPI_FLASH_PAGE_SIZE;
+    if (data_length > SPI_FLASH_PAGE_SIZE - page_offset || !in_range(address, data_length)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < data_length; i++) {
+        sim_flash[address + i] &= data[i];
+    }
+    sim_flash_stats.page_programs++;
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    if (!in_range(address, data_length)) {
+        return false;
+    }
+    memcpy(data, sim_flash + address, data_length);
+    sim_flash_stats.reads++;
+    sim_flash_stats.bytes_read += data_length;
+    return true;
+}
+
+void spi_flash_init(void) {
+    // Keep the contents across soft resets, like a real chip would.
+    if (!sim_flash_erased) {
+        memset(sim_flash, 0xff, sizeof(sim_flash));
+        sim_flash_erased = true;
+    }
+    write_enable_latch = false;
+}
+
+void spi_flash_init_device(const external_flash_device *device) {
+}
@@ -0,0 +1,48 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <stdint.h>
+
+#include "supervisor/shared/external_flash/device.h"
+
+// Size of the simulated flash chip.
+#ifndef SIM_FLASH_SIZE
+#define SIM_FLASH_SIZE (2 * 1024 * 1024)
+#endif
+
+// The simulated chip answers the JEDEC ID of a GD25Q16C. external_flash.c looks
+// for it instead of EXTERNAL_FLASH_DEVICES when SIM_FLASH_FILESYSTEM is on.
+#define SIM_FLASH_DEVICE { \
+        .total_size = SIM_FLASH_SIZE, \
+        .start_up_time_us = 0, \
+        .manufacturer_id = 0xc8, \
+        .memory_type = 0x40, \
+        .capacity = 0x15, \
+        .max_clock_speed_mhz = 104, \
+        .quad_enable_bit_mask = 0x02, \
+        .has_sector_protection = false, \
+        .supports_fast_read = true, \
+        .supports_qspi = false, \
+        .supports_qspi_writes = false, \
+        .write_status_register_split = false, \
+        .single_status_byte = false, \
+        .no_ready_bit = false, \
+        .no_erase_cmd = false, \
+        .no_reset_cmd = false, \
+}
+
+typedef struct {
+    uint32_t sector_erases;
+    uint32_t page_programs;
+    uint32_t reads;
+    uint32_t bytes_read;
+} sim_flash_stats_t;
+
+// Operation counts since start up or the last sim_flash_reset_stats().
+extern sim_flash_stats_t sim_flash_stats;
+
+void sim_flash_reset_stats(void);
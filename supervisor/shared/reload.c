@@ -6,6 +6,7 @@
 
 #include "reload.h"
 
+#include "extmod/vfs.h"
 #include "py/mphal.h"
 #include "py/mpstate.h"
 #include "supervisor/port.h"
@@ -61,6 +62,8 @@ inline bool autoreload_is_enabled() {
 }
 
 void autoreload_trigger() {
+    // Every caller has just changed the filesystem, even if no reload follows.
+    mp_vfs_import_stat_cache_invalidate();
     if (!autoreload_enabled || autoreload_suspended != 0) {
         return;
     }
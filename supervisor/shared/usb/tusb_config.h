@@ -125,6 +125,25 @@ extern "C" {
 
 // Product revision string included in Inquiry response, max 4 bytes
 #define CFG_TUD_MSC_PRODUCT_REV     "1.0"
+
+// READ10 and WRITE10 data is passed to the callbacks in chunks of up to this
+// many bytes. More than one block per chunk lets the flash read or write
+// several blocks at once. The buffer is always allocated, so ports with less
+// than 64kB of ram (such as the SAMD21) stay at one block. Ports that don't
+// say how much ram they have go by whether they are full builds.
+#ifndef CFG_TUD_MSC_EP_BUFSIZE
+#if defined(RAM_SIZE)
+#if RAM_SIZE >= (64 * 1024)
+#define CFG_TUD_MSC_EP_BUFSIZE      (4096)
+#else
+#define CFG_TUD_MSC_EP_BUFSIZE      (512)
+#endif
+#elif CIRCUITPY_FULL_BUILD
+#define CFG_TUD_MSC_EP_BUFSIZE      (4096)
+#else
+#define CFG_TUD_MSC_EP_BUFSIZE      (512)
+#endif
+#endif
 #endif
 
 // --------------------------------------------------------------------+
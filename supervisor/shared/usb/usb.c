@@ -185,6 +185,10 @@ void usb_background(void) {
         #if CIRCUITPY_USB_HOST || CIRCUITPY_MAX3421E
         tuh_task();
         #endif
+        #if CIRCUITPY_USB_DEVICE && CIRCUITPY_USB_CDC
+        // The CDC streams may have received data or emptied their output buffers.
+        usb_cdc_poll_notify();
+        #endif
         #elif CFG_TUSB_OS == OPT_OS_FREERTOS
         // Yield to FreeRTOS in case TinyUSB runs in a separate task. Don't use
         // port_yield() because it has a longer delay.
@@ -252,15 +252,16 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
     fs_user_mount_t *vfs = get_vfs(lun);
     disk_write(vfs, buffer, lba, block_count);
     // Since by getting here we assume the mount is read-only to
-    // MicroPython let's update the cached FatFs sector if it's the one
-    // we just wrote.
+    // MicroPython let's update the cached FatFs sector if it's one of the
+    // ones we just wrote.
     #if FF_MAX_SS != FF_MIN_SS
     if (vfs->fatfs.ssize == MSC_FLASH_BLOCK_SIZE) {
     #else
     // The compiler can optimize this away.
     if (FF_MAX_SS == FILESYSTEM_BLOCK_SIZE) {
         #endif
-        if (lba == vfs->fatfs.winsect && lba > 0) {
+        if (vfs->fatfs.winsect > 0 && vfs->fatfs.winsect >= lba &&
+            vfs->fatfs.winsect - lba < block_count) {
             memcpy(vfs->fatfs.win,
                 buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
                 MSC_FLASH_BLOCK_SIZE);
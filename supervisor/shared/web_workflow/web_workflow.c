@@ -25,6 +25,7 @@
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
 #include "supervisor/shared/workflow.h"
+#include "supervisor/workflow.h"
 
 #include "shared-bindings/hashlib/__init__.h"
 #include "shared-bindings/hashlib/Hash.h"
@@ -79,11 +80,49 @@ typedef struct {
     bool json;
     bool websocket;
     bool new_socket;
+    bool range;
+    // A suffix range ("bytes=-n") requests the last range_end bytes.
+    bool range_suffix;
+    size_t range_start;
+    // Inclusive, like the header. SIZE_MAX when the range is open ended.
+    size_t range_end;
     uint32_t websocket_version;
     // RFC6455 for websockets says this header should be 24 base64 characters long.
     char websocket_key[24 + 1];
 } _request;
 
+// File contents are moved through this buffer. Sector multiples let FATFS read and write
+// straight to and from it instead of going through its window.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE (1024)
+#endif
+
+// How many buffers a transfer moves per background call before letting other work run.
+#define TRANSFER_BUFFERS_PER_CALL (4)
+
+enum transfer_state {
+    TRANSFER_NONE,
+    TRANSFER_SEND_FILE,
+    TRANSFER_RECEIVE_FILE
+};
+
+// File transfers are run a few buffers at a time from the background callback so that
+// large files don't stall the VM or other workflows while waiting on the network.
+typedef struct {
+    enum transfer_state state;
+    FIL file;
+    fs_user_mount_t *fs_mount;
+    // Bytes left to read from the file (send) or the socket (receive).
+    size_t remaining;
+    // Bytes in buffer and how many of them have been sent. (Receives always start at 0.)
+    size_t buffered;
+    size_t buffer_offset;
+    DWORD fattime;
+    int nodelay_ok;
+    bool new_file;
+    uint8_t buffer[CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE];
+} _transfer;
+
 static wifi_radio_error_t _wifi_status = WIFI_RADIO_ERROR_NONE;
 
 #if CIRCUITPY_STATUS_BAR
@@ -104,6 +143,7 @@ static socketpool_socket_obj_t listening;
 static socketpool_socket_obj_t active;
 
 static _request active_request;
+static _transfer active_transfer;
 
 static char _api_password[64];
 static char web_instance_name[50];
@@ -112,6 +152,8 @@ static char web_instance_name[50];
 static uint32_t _encoded_ip = 0;
 static char _our_ip_encoded[4 * 4];
 
+static void _abort_transfer(_request *request);
+
 // in_len is the number of bytes to encode. out_len is the number of bytes we
 // have to do it.
 static bool _base64_in_place(char *buf, size_t in_len, size_t out_len) {
@@ -239,6 +281,14 @@ void supervisor_web_workflow_status(void) {
 bool supervisor_start_web_workflow(void) {
     #if CIRCUITPY_WEB_WORKFLOW && CIRCUITPY_WIFI && CIRCUITPY_OS_GETENV
 
+    // Drop any transfer left from the last VM before anything can return early.
+    if (active_transfer.state != TRANSFER_NONE) {
+        _abort_transfer(&active_request);
+        if (!common_hal_socketpool_socket_get_closed(&active)) {
+            common_hal_socketpool_socket_close(&active);
+        }
+    }
+
     char ssid[33];
     char password[64];
 
@@ -544,7 +594,7 @@ static void _reply_access_control(socketpool_socket_obj_t *socket, _request *req
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n",
         "Access-Control-Expose-Headers: Access-Control-Allow-Methods\r\n",
-        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization\r\n",
+        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization, Range\r\n",
         "Access-Control-Allow-Methods:GET, OPTIONS, PUT, DELETE, MOVE", NULL);
     _send_str(socket, "\r\n");
     _cors_header(socket, request);
@@ -736,12 +786,46 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
     _send_chunk(socket, "");
 }
 
-static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
-    uint32_t total_length = f_size(active_file);
+// Sends the headers for active_transfer.file and starts sending its contents. The file is
+// closed here when there is nothing to send.
+static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename) {
+    FIL *active_file = &active_transfer.file;
+    uint32_t file_size = f_size(active_file);
+    uint32_t start = 0;
+    uint32_t end = file_size;
+    bool satisfiable = true;
+    if (request->range) {
+        if (request->range_suffix) {
+            satisfiable = request->range_end > 0;
+            start = file_size - MIN(request->range_end, file_size);
+        } else {
+            satisfiable = request->range_start < file_size;
+            start = request->range_start;
+            end = MIN(request->range_end, file_size - 1) + 1;
+        }
+        satisfiable = satisfiable && file_size > 0;
+    }
 
-    _send_str(socket, "HTTP/1.1 200 OK\r\n");
     mp_print_t _socket_print = {socket, _print_raw};
+    if (!satisfiable) {
+        f_close(active_file);
+        _send_str(socket, "HTTP/1.1 416 Range Not Satisfiable\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes */%u\r\n", file_size);
+        _send_str(socket, "Content-Length: 0\r\n");
+        _cors_header(socket, request);
+        _send_final_str(socket, "\r\n");
+        return;
+    }
+
+    uint32_t total_length = end - start;
+    if (request->range) {
+        _send_str(socket, "HTTP/1.1 206 Partial Content\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes %u-%u/%u\r\n", start, end - 1, file_size);
+    } else {
+        _send_str(socket, "HTTP/1.1 200 OK\r\n");
+    }
     mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
+    _send_str(socket, "Accept-Ranges: bytes\r\n");
     // TODO: Make this a table to save space.
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
         _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
@@ -755,44 +839,77 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
         _send_strs(socket, "Content-Type:", "application/octet-stream\r\n", NULL);
     }
     _cors_header(socket, request);
+
+    if (total_length == 0 || (start > 0 && f_lseek(active_file, start) != FR_OK)) {
+        f_close(active_file);
+        _send_final_str(socket, "\r\n");
+        return;
+    }
     _send_str(socket, "\r\n");
 
-    uint32_t total_read = 0;
-    int nodelay_ok = -1;
-    while (total_read < total_length) {
-        uint8_t data_buffer[64];
-        size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
-        total_read += quantity_read;
-        // When getting near the end of the file, disable Nagle's combining algorithm so that
-        // data is sent immediately.
-        if (total_length - total_read < 64) {
-            int nodelay = 1;
-            // Returns 0 when it works.
-            nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-        }
-        uint32_t send_offset = 0;
-        while (send_offset < quantity_read) {
-            int sent = socketpool_socket_send(socket, data_buffer + send_offset, quantity_read - send_offset);
-            if (sent < 0) {
-                if (sent == -MP_EAGAIN) {
-                    sent = 0;
-                } else {
-                    break;
-                }
+    active_transfer.state = TRANSFER_SEND_FILE;
+    active_transfer.remaining = total_length;
+    active_transfer.buffered = 0;
+    active_transfer.buffer_offset = 0;
+    active_transfer.nodelay_ok = -1;
+}
+
+// Returns true once the file has been sent or sending failed.
+static bool _send_file_step(socketpool_socket_obj_t *socket) {
+    size_t moved = 0;
+    bool error = false;
+    while (active_transfer.buffer_offset < active_transfer.buffered || active_transfer.remaining > 0) {
+        if (active_transfer.buffer_offset == active_transfer.buffered) {
+            if (moved >= TRANSFER_BUFFERS_PER_CALL * sizeof(active_transfer.buffer)) {
+                // Come back for more after everything else has had a turn.
+                supervisor_workflow_request_background();
+                return false;
+            }
+            UINT quantity_read;
+            size_t read_len = MIN(sizeof(active_transfer.buffer), active_transfer.remaining);
+            FRESULT result = f_read(&active_transfer.file, active_transfer.buffer, read_len, &quantity_read);
+            if (result != FR_OK || quantity_read == 0) {
+                error = true;
+                break;
             }
-            send_offset += sent;
+            active_transfer.remaining -= quantity_read;
+            active_transfer.buffered = quantity_read;
+            active_transfer.buffer_offset = 0;
+            // Disable Nagle's combining algorithm for the last buffer so that data is sent
+            // immediately.
+            if (active_transfer.remaining == 0) {
+                int nodelay = 1;
+                // Returns 0 when it works.
+                active_transfer.nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
+            }
+        }
+        int sent = socketpool_socket_send(socket,
+            active_transfer.buffer + active_transfer.buffer_offset,
+            active_transfer.buffered - active_transfer.buffer_offset);
+        if (sent == -MP_EAGAIN) {
+            // The socket doesn't tell us when it can send again so poll from the background.
+            supervisor_workflow_request_background();
+            return false;
         }
+        if (sent < 0) {
+            error = true;
+            break;
+        }
+        active_transfer.buffer_offset += sent;
+        moved += sent;
     }
-    if (total_read < total_length) {
+
+    f_close(&active_transfer.file);
+    active_transfer.state = TRANSFER_NONE;
+    if (error) {
         socketpool_socket_close(socket);
     }
-
     // Re-enable Nagle's algorithm when done sending.
-    if (nodelay_ok == 0) {
+    if (active_transfer.nodelay_ok == 0) {
         int nodelay = 0;
-        nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
+        common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
     }
+    return true;
 }
 
 static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *request) {
@@ -956,29 +1073,31 @@ static void _discard_incoming(socketpool_socket_obj_t *socket, size_t amount) {
     }
 }
 
+// Opens the file and starts receiving its contents into active_transfer. Replies right away
+// when the file can't be written.
 static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, const TCHAR *path) {
-    FIL active_file;
+    FIL *active_file = &active_transfer.file;
 
     if (!filesystem_lock(fs_mount)) {
         _discard_incoming(socket, request->content_length);
         _reply_conflict(socket, request);
         return;
     }
+    DWORD fattime = 0;
     if (request->timestamp_ms > 0) {
-        DWORD fattime;
         truncate_time(request->timestamp_ms * 1000000, &fattime);
         override_fattime(fattime);
     }
 
     FATFS *fs = &fs_mount->fatfs;
-    FRESULT result = f_open(fs, &active_file, path, FA_WRITE);
+    FRESULT result = f_open(fs, active_file, path, FA_WRITE);
     bool new_file = false;
     size_t old_length = 0;
     if (result == FR_NO_FILE) {
         new_file = true;
-        result = f_open(fs, &active_file, path, FA_WRITE | FA_OPEN_ALWAYS);
+        result = f_open(fs, active_file, path, FA_WRITE | FA_OPEN_ALWAYS);
     } else {
-        old_length = f_size(&active_file);
+        old_length = f_size(active_file);
     }
 
     if (result == FR_NO_PATH) {
@@ -997,14 +1116,14 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     }
 
     // Change the file size to start.
-    f_lseek(&active_file, request->content_length);
-    if (f_tell(&active_file) < request->content_length) {
+    f_lseek(active_file, request->content_length);
+    if (f_tell(active_file) < request->content_length) {
         if (!new_file) {
             // Truncate the file back to the old length.
-            f_lseek(&active_file, old_length);
-            f_truncate(&active_file);
+            f_lseek(active_file, old_length);
+            f_truncate(active_file);
         }
-        f_close(&active_file);
+        f_close(active_file);
 
         if (new_file) {
             f_unlink(fs, path);
@@ -1022,43 +1141,70 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     } else if (request->expect) {
         _reply_continue(socket, request);
     }
-    f_truncate(&active_file);
-    f_rewind(&active_file);
+    f_truncate(active_file);
+    f_rewind(active_file);
+    // Only the timestamps written on close need the override. Don't leave it set for other
+    // file system users while the data arrives.
+    override_fattime(0);
 
-    size_t total_read = 0;
+    active_transfer.state = TRANSFER_RECEIVE_FILE;
+    active_transfer.fs_mount = fs_mount;
+    active_transfer.remaining = request->content_length;
+    active_transfer.buffered = 0;
+    active_transfer.fattime = fattime;
+    active_transfer.new_file = new_file;
+}
+
+// Returns true once the whole file has been received and the reply sent.
+static bool _receive_file_step(socketpool_socket_obj_t *socket, _request *request) {
+    size_t moved = 0;
     bool error = false;
-    while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
-        if (len < 0) {
-            if (len == -MP_EAGAIN) {
-                continue;
-            }
-            error = true;
-            break;
+    while (active_transfer.remaining > 0) {
+        if (moved >= TRANSFER_BUFFERS_PER_CALL * sizeof(active_transfer.buffer)) {
+            supervisor_workflow_request_background();
+            return false;
         }
-        total_read += len;
-        UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
+        size_t read_len = MIN(sizeof(active_transfer.buffer) - active_transfer.buffered, active_transfer.remaining);
+        int len = socketpool_socket_recv_into(socket, active_transfer.buffer + active_transfer.buffered, read_len);
+        if (len == -MP_EAGAIN) {
+            // We'll be called again when more data arrives.
+            return false;
+        }
+        if (len <= 0) {
             error = true;
             break;
         }
+        active_transfer.remaining -= len;
+        active_transfer.buffered += len;
+        moved += len;
+        if (active_transfer.buffered == sizeof(active_transfer.buffer) || active_transfer.remaining == 0) {
+            UINT actual;
+            f_write(&active_transfer.file, active_transfer.buffer, active_transfer.buffered, &actual);
+            if (actual < active_transfer.buffered) {
+                error = true;
+                break;
+            }
+            active_transfer.buffered = 0;
+        }
     }
 
-    f_close(&active_file);
-    filesystem_unlock(fs_mount);
-
+    if (active_transfer.fattime != 0) {
+        override_fattime(active_transfer.fattime);
+    }
+    f_close(&active_transfer.file);
     override_fattime(0);
+    filesystem_unlock(active_transfer.fs_mount);
+    active_transfer.state = TRANSFER_NONE;
+
     if (error) {
-        _discard_incoming(socket, request->content_length - total_read);
+        // The rest of the upload isn't read. The socket is closed after the reply.
         _reply_server_error(socket, request);
-    } else if (new_file) {
+    } else if (active_transfer.new_file) {
         _reply_created(socket, request);
     } else {
         _reply_no_content(socket, request);
     }
+    return true;
 }
 
 #define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint8_t filename[]; extern const char *filename##_content_type;
@@ -1300,16 +1446,14 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
                 }
             } else { // Dealing with a file.
                 if (strcasecmp(request->method, "GET") == 0) {
-                    FIL active_file;
-                    FRESULT result = f_open(fs, &active_file, path, FA_READ);
+                    active_transfer.fs_mount = fs_mount;
+                    FRESULT result = f_open(fs, &active_transfer.file, path, FA_READ);
 
                     if (result != FR_OK) {
                         _reply_missing(socket, request);
                     } else {
-                        _reply_with_file(socket, request, path, &active_file);
+                        _reply_with_file(socket, request, path);
                     }
-
-                    f_close(&active_file);
                 } else if (strcasecmp(request->method, "PUT") == 0) {
                     _write_file_and_reply(socket, request, fs_mount, path);
                     return true;
@@ -1399,9 +1543,101 @@ static void _reset_request(_request *request) {
     request->expect = false;
     request->json = false;
     request->websocket = false;
+    request->range = false;
+    request->range_suffix = false;
+}
+
+static void _finish_request(socketpool_socket_obj_t *socket, _request *request, bool reload) {
+    _reset_request(request);
+    common_hal_socketpool_socket_close(socket);
+    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
+    if (reload) {
+        autoreload_trigger();
+    }
+}
+
+static void _continue_transfer(socketpool_socket_obj_t *socket, _request *request) {
+    bool reload = active_transfer.state == TRANSFER_RECEIVE_FILE;
+    // Only CIRCUITPY outlives the VM. Other mounts, like /sd, can be unmounted and freed
+    // between background calls, so their files are moved in one go.
+    bool in_one_go = active_transfer.fs_mount != filesystem_circuitpy();
+    bool finished;
+    do {
+        if (reload) {
+            finished = _receive_file_step(socket, request);
+        } else {
+            finished = _send_file_step(socket);
+        }
+    } while (!finished && in_one_go);
+    if (finished) {
+        _finish_request(socket, request, reload);
+    }
+}
+
+// Drops a transfer whose connection went away. Only transfers on CIRCUITPY are left
+// unfinished between calls, so the file's mount is still there.
+static void _abort_transfer(_request *request) {
+    if (active_transfer.state == TRANSFER_NONE) {
+        return;
+    }
+    bool reload = active_transfer.state == TRANSFER_RECEIVE_FILE;
+    f_close(&active_transfer.file);
+    if (reload) {
+        filesystem_unlock(active_transfer.fs_mount);
+    }
+    active_transfer.state = TRANSFER_NONE;
+    _reset_request(request);
+    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
+    if (reload) {
+        autoreload_trigger();
+    }
+}
+
+// Only single ranges are supported. Anything else is ignored and the whole file is sent.
+static void _parse_range(_request *request) {
+    const char *prefix = "bytes=";
+    const char *value = request->header_value;
+    if (strncmp(value, prefix, strlen(prefix)) != 0) {
+        return;
+    }
+    value += strlen(prefix);
+    char *end;
+    if (*value == '-') {
+        value++;
+        if (!unichar_isdigit(*value)) {
+            return;
+        }
+        request->range_end = strtoul(value, &end, 10);
+        request->range_suffix = true;
+    } else {
+        if (!unichar_isdigit(*value)) {
+            return;
+        }
+        request->range_start = strtoul(value, &end, 10);
+        if (*end != '-') {
+            return;
+        }
+        value = end + 1;
+        if (*value == '\0') {
+            request->range_end = SIZE_MAX;
+            end = (char *)value;
+        } else if (unichar_isdigit(*value)) {
+            request->range_end = strtoul(value, &end, 10);
+        } else {
+            return;
+        }
+        if (request->range_end < request->range_start) {
+            return;
+        }
+    }
+    request->range = *end == '\0';
 }
 
 static void _process_request(socketpool_socket_obj_t *socket, _request *request) {
+    if (active_transfer.state != TRANSFER_NONE) {
+        _continue_transfer(socket, request);
+        return;
+    }
     bool more = true;
     bool error = false;
     uint8_t c;
@@ -1518,6 +1754,8 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                         strcpy(request->websocket_key, request->header_value);
                     } else if (strcasecmp(request->header_key, "X-Destination") == 0) {
                         strcpy(request->destination, request->header_value);
+                    } else if (strcasecmp(request->header_key, "Range") == 0) {
+                        _parse_range(request);
                     }
                 } else if (request->offset > sizeof(request->header_value) - 1) {
                     // Skip methods that are too long.
@@ -1545,12 +1783,12 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
         return;
     }
     bool reload = _reply(socket, request);
-    _reset_request(request);
-    common_hal_socketpool_socket_close(socket);
-    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
-    if (reload) {
-        autoreload_trigger();
+    if (active_transfer.state != TRANSFER_NONE) {
+        // The transfer finishes the request.
+        _continue_transfer(socket, request);
+        return;
     }
+    _finish_request(socket, request, reload);
 }
 
 static bool supervisor_filesystem_access_could_block(void) {
@@ -1587,6 +1825,7 @@ void supervisor_web_workflow_background(void *data) {
                 break;
             }
         } else {
+            _abort_transfer(&active_request);
             // Close the active socket if necessary
             if (!common_hal_socketpool_socket_get_closed(&active)) {
                 common_hal_socketpool_socket_close(&active);
@@ -59,6 +59,11 @@ CFLAGS += -DQSPI_FLASH_FILESYSTEM=$(QSPI_FLASH_FILESYSTEM)
 SPI_FLASH_FILESYSTEM ?= 0
 CFLAGS += -DSPI_FLASH_FILESYSTEM=$(SPI_FLASH_FILESYSTEM)
 
+# Simulated SPI flash in ram, for exercising the external flash cache without hardware.
+# It stands in for the chips in EXTERNAL_FLASH_DEVICES.
+SIM_FLASH_FILESYSTEM ?= 0
+CFLAGS += -DSIM_FLASH_FILESYSTEM=$(SIM_FLASH_FILESYSTEM)
+
 DISABLE_FILESYSTEM ?= 0
 CFLAGS += -DDISABLE_FILESYSTEM=$(DISABLE_FILESYSTEM)
 
@@ -87,6 +92,9 @@ else
   ifeq ($(QSPI_FLASH_FILESYSTEM),1)
     SRC_SUPERVISOR += supervisor/qspi_flash.c supervisor/shared/external_flash/qspi_flash.c
   endif
+  ifeq ($(SIM_FLASH_FILESYSTEM),1)
+    SRC_SUPERVISOR += supervisor/shared/external_flash/sim_flash.c
+  endif
 
 OBJ_EXTRA_ORDER_DEPS += $(HEADER_BUILD)/devices.h
 SRC_QSTR += $(HEADER_BUILD)/devices.h
@@ -39,3 +39,22 @@ dump_bitmap(b)
 b = make_circle_bitmap()
 bitmapfilter.morph(b, weights=sharpen, threshold=True, add=0.125, invert=True)
 dump_bitmap(b)
+
+# Box and separable kernels take faster paths, which must give the same results
+box5 = [1] * 25
+gauss5 = [a * b for a in (1, 4, 6, 4, 1) for b in (1, 4, 6, 4, 1)]
+b = make_circle_bitmap()
+bitmapfilter.morph(b, weights=box5)
+dump_bitmap(b)
+
+b = make_circle_bitmap()
+bitmapfilter.morph(b, mask=q, weights=gauss5)
+dump_bitmap(b)
+
+# A separable kernel with weights large enough that its two-pass sums would
+# overflow is filtered by the general path instead
+b = make_circle_bitmap()
+bitmapfilter.morph(b, weights=blur)
+c = make_circle_bitmap()
+bitmapfilter.morph(c, weights=[w * 4096 for w in blur])
+print(all(b[i] == c[i] for i in range(b.width * b.height)))
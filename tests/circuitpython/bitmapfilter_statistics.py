@@ -0,0 +1,73 @@
+import array
+from displayio import Bitmap
+import bitmapfilter
+from blinka_image import decode_resource
+
+
+def test_pattern():
+    return decode_resource("testpattern", 2)
+
+
+def make_quadrant_bitmap(width, height):
+    # The quadrant pattern covers the top left 17x17 pixels
+    b = Bitmap(width, height, 1)
+    for i in range(17):
+        for j in range(17):
+            b[i, j] = (i < 8) ^ (j < 8)
+    return b
+
+
+def print_stats(s):
+    print("count", s.count)
+    for name, c in (("r", s.r), ("g", s.g), ("b", s.b)):
+        print(name, len(c.histogram), sum(c.histogram), c.min, c.max, "%.3f %.3f" % (c.mean, c.stddev))
+
+
+b = test_pattern()
+print("rgb565")
+print_stats(bitmapfilter.statistics(b))
+
+q = make_quadrant_bitmap(b.width, b.height)
+print("rgb565 (masked)")
+print_stats(bitmapfilter.statistics(b, mask=q))
+
+print("l8")
+g = Bitmap(5, 4, 256)
+for y in range(g.height):
+    for x in range(g.width):
+        g[x, y] = x * 10 + y
+integral = array.array("I", [0xFFFFFFFF] * ((g.width + 1) * (g.height + 1)))
+s = bitmapfilter.statistics(g, integral=integral)
+print_stats(s)
+print(s.r is s.g is s.b, [i for i, n in enumerate(s.r.histogram) if n])
+for y in range(g.height + 1):
+    print(list(integral[y * (g.width + 1) : (y + 1) * (g.width + 1)]))
+
+
+def region_sum(S, stride, x1, y1, x2, y2):
+    return S[y2 * stride + x2] - S[y1 * stride + x2] - S[y2 * stride + x1] + S[y1 * stride + x1]
+
+
+print(region_sum(integral, g.width + 1, 1, 1, 4, 3), sum(g[x, y] for x in range(1, 4) for y in range(1, 3)))
+
+print("rgb565 integral")
+integral = array.array("I", [0] * ((b.width + 1) * (b.height + 1)))
+bitmapfilter.statistics(b, integral=integral)
+print(integral[-1])
+
+try:
+    bitmapfilter.statistics(g, integral=array.array("I", [0] * 10))
+except ValueError as e:
+    print("ValueError", e)
+
+# the integral buffer must hold unsigned 32-bit integers
+for typecode in ("f", "i"):
+    try:
+        bitmapfilter.statistics(g, integral=array.array(typecode, [0] * 30))
+    except ValueError as e:
+        print("ValueError", typecode, e)
+
+try:
+    bitmapfilter.statistics(g, mask=Bitmap(4, 4, 1))
+except ValueError as e:
+    print("ValueError", e)
@@ -0,0 +1,144 @@
+import os
+import struct
+
+try:
+    import ble_file_transfer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMBlockDevice(128)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+
+READ = 0x10
+READ_DATA = 0x11
+READ_PACING = 0x12
+WRITE = 0x20
+WRITE_PACING = 0x21
+WRITE_DATA = 0x22
+TRANSFER_WINDOWED = 0x01
+TRANSFER_RESEND = 0x02
+STATUS_OK = 0x01
+
+PACKET_LENGTH = 64
+# Each WRITE_DATA fills one packet after its 12 byte header.
+CHUNK = PACKET_LENGTH - 12
+# Packets the central gets out per connection event.
+PER_EVENT = 3
+
+print("version", ble_file_transfer.start(PACKET_LENGTH))
+
+data = bytes((i * 7 + (i >> 9)) & 0xFF for i in range(3000))
+
+
+def send(command):
+    for i in range(0, len(command), PACKET_LENGTH):
+        ble_file_transfer.write(command[i : i + PACKET_LENGTH])
+
+
+def pacings(notified):
+    result = []
+    for i in range(0, len(notified), 20):
+        command, status, flags, _, offset, _, free_space = struct.unpack_from(
+            "<BBBBIQI", notified, i
+        )
+        assert command == WRITE_PACING and status == STATUS_OK
+        result.append((offset, free_space, flags))
+    return result
+
+
+# Writes data as a windowed central would and returns the WRITE_PACINGs it got. The
+# WRITE_DATA for each offset in lose is lost the first time it is sent.
+def write(path, lose=()):
+    lose = list(lose)
+    header = struct.pack("<BBHIQI", WRITE, TRANSFER_WINDOWED, len(path), 0, 0, len(data))
+    send(header + path.encode())
+    ble_file_transfer.background()
+    log = pacings(ble_file_transfer.read())
+    sent, window, _ = log[0]
+    limit = sent + window
+    while window:
+        for _ in range(PER_EVENT):
+            if sent >= limit:
+                break
+            n = min(CHUNK, limit - sent)
+            if sent in lose:
+                lose.remove(sent)
+            else:
+                header = struct.pack("<BBHII", WRITE_DATA, STATUS_OK, 0, sent, n)
+                send(header + data[sent : sent + n])
+            sent += n
+        ble_file_transfer.background()
+        for offset, window, flags in pacings(ble_file_transfer.read()):
+            log.append((offset, window, flags))
+            limit = offset + window
+            if flags & TRANSFER_RESEND:
+                sent = offset
+    return log
+
+
+def check(path):
+    with open(path, "rb") as f:
+        print(path, f.read() == data)
+
+
+log = write("/ramdisk/clean.bin")
+print("clean", len(log), [p for p in log if p[2]])
+check("/ramdisk/clean.bin")
+
+# A lost packet mid-window: the peripheral asks for it again instead of leaving a hole.
+log = write("/ramdisk/lost.bin", lose=(CHUNK * 10,))
+print("lost", [p for p in log if p[2]])
+check("/ramdisk/lost.bin")
+
+# The resent packet is lost too, and then another one in a later window.
+log = write("/ramdisk/twice.bin", lose=(CHUNK * 10, CHUNK * 10, CHUNK * 24))
+print("twice", [p for p in log if p[2]])
+check("/ramdisk/twice.bin")
+
+print("reloads", ble_file_transfer.reloads() > 0)
+
+# A windowed read of the repaired file.
+path = "/ramdisk/twice.bin"
+send(struct.pack("<BBHII", READ, TRANSFER_WINDOWED, len(path), 0, 1024) + path.encode())
+ble_file_transfer.background()
+received = bytearray()
+notified = ble_file_transfer.read()
+while True:
+    command, status, _, offset, total, size = struct.unpack_from("<BBHIII", notified)
+    assert command == READ_DATA and status == STATUS_OK and offset == len(received)
+    received += notified[16 : 16 + size]
+    notified = notified[16 + size :]
+    if len(received) == total:
+        break
+    if not notified:
+        send(struct.pack("<BBHII", READ_PACING, STATUS_OK, 0, len(received), 1024))
+        ble_file_transfer.background()
+        notified = ble_file_transfer.read()
+print("read", received == data)
+
+ble_file_transfer.disconnect()
+os.umount("/ramdisk")
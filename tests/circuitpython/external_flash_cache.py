@@ -0,0 +1,122 @@
+try:
+    import external_flash_sim as sim
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+BLOCK = 512
+# Blocks per erase sector.
+SECTOR = 8
+
+print("blocks", sim.init())
+
+
+def data(tag, block):
+    return bytes((tag, block & 0xFF)) * (BLOCK // 2)
+
+
+def write(tag, block, count=1):
+    for b in range(block, block + count):
+        sim.writeblocks(b, data(tag, b))
+
+
+def read(block):
+    buf = bytearray(BLOCK)
+    sim.readblocks(block, buf)
+    return bytes(buf)
+
+
+def raw(block):
+    buf = bytearray(BLOCK)
+    sim.raw(block, buf)
+    return bytes(buf)
+
+
+# Which of the given sectors have tag in their first block on the chip itself.
+def on_flash(tag, sectors):
+    return [s for s in sectors if raw(s * SECTOR) == data(tag, s * SECTOR)]
+
+
+# Sectors 1 to 6 start out full, so new writes to them have to be cached.
+sectors = list(range(1, 7))
+for s in sectors:
+    write(1, s * SECTOR, SECTOR)
+sim.release()
+sim.stats()
+
+# Four sectors fit in the cache. Touching sector 1 again makes sector 2 the
+# least recently written, so it is the one written back to make room for 5.
+for s in sectors[:4]:
+    write(2, s * SECTOR)
+write(2, 1 * SECTOR)
+print("cached", on_flash(2, sectors), sim.stats()[0])
+write(2, 5 * SECTOR)
+print("evict", on_flash(2, sectors), sim.stats()[0])
+write(2, 6 * SECTOR)
+print("evict", on_flash(2, sectors), sim.stats()[0])
+
+# The rest of each written back sector survived the erase.
+rest = [b for s in (2, 3) for b in range(s * SECTOR + 1, (s + 1) * SECTOR)]
+print("kept", all(raw(b) == data(1, b) for b in rest))
+# Reads see the cached blocks before they are written back.
+print("read cached", all(read(s * SECTOR) == data(2, s * SECTOR) for s in sectors))
+sim.release()
+print("release", on_flash(2, sectors), sim.stats()[0])
+
+# Sequential reads fill the read ahead buffer. Blocks written after that, both
+# into the cache and directly onto erased flash, must not be read from it.
+for start, tag in ((1 * SECTOR, 3), (100 * SECTOR, 4)):
+    read(start - 1)
+    before = read(start)
+    sim.stats()
+    print("read ahead", read(start + 1) == raw(start + 1), sim.stats()[2])
+    write(tag, start + 2)
+    print("read after write", read(start + 2) == data(tag, start + 2), before == read(start))
+    sim.flush()
+    after = read(start + 2)
+    print("read after flush", after == data(tag, start + 2), raw(start + 2) == after)
+sim.release()
+
+# Reads as big as the buffer, like USB transfers, bypass it and go to the
+# flash in one read each.
+allocs = sim.ram()[0]
+buf = bytearray(SECTOR * BLOCK)
+sim.stats()
+for start in range(200 * SECTOR, 204 * SECTOR, SECTOR):
+    sim.readblocks(start, buf)
+print("bypass", sim.stats()[2], sim.ram()[0] == allocs)
+
+# Periodic flushes keep the ram of every cached sector, and the read ahead
+# buffer, while the flash is busy, so a copy doesn't free and reallocate it.
+print("idle ram", sim.ram()[1], sim.ticks_held())
+for s in sectors[:4]:
+    write(5, s * SECTOR)
+read(99 * SECTOR - 1)
+read(99 * SECTOR)
+allocs, busy = sim.ram()
+sim.flush()
+print("busy flush", sim.ram() == (allocs, busy), sim.ticks_held())
+# The flush emptied the read ahead buffer, but refilling it needs no new ram.
+print("refill", read(99 * SECTOR + 1) == raw(99 * SECTOR + 1), sim.ram() == (allocs, busy))
+sim.advance(1000)
+for s in sectors[:4]:
+    write(6, s * SECTOR)
+read(99 * SECTOR - 1)
+read(99 * SECTOR)
+print("rewrite", sim.ram() == (allocs, busy))
+sim.advance(1000)
+sim.flush()
+print("busy flush", sim.ram() == (allocs, busy), sim.ticks_held())
+print("written", on_flash(6, sectors))
+
+# Once it has been idle long enough, all but one sector go back to the heap.
+sim.advance(5000)
+sim.flush()
+one = sim.ram()[1]
+print("idle flush", 0 < one and one * 4 < busy, sim.ticks_held())
+write(7, 1 * SECTOR)
+print("reuse", sim.ram() == (allocs, one))
+write(7, 2 * SECTOR)
+print("realloc", sim.ram()[0] > allocs)
+sim.release()
+print("release", sim.ram()[1], sim.ticks_held())
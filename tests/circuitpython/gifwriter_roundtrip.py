@@ -0,0 +1,127 @@
+import os
+
+try:
+    from displayio import Bitmap, Colorspace
+    from gifio import GifWriter, OnDiskGif
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMBlockDevice(128)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+
+# Large enough that noise fills the LZW dictionary and forces a clear code
+W, H = 64, 64
+seed = 1
+
+
+def rand():
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return seed >> 16
+
+
+def bswap16(v):
+    return ((v & 0xFF) << 8) | (v >> 8)
+
+
+def rgb565(r, g, b):
+    # As OnDiskGif stores it: byte-swapped RGB565
+    return bswap16(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+
+
+def l8_color(v):
+    gray = int(((v >> 1) * 255 + 63.5) / 127)
+    return rgb565(gray, gray, gray)
+
+
+def rgb565_color(p):
+    r = int((((p >> 14) & 3) * 255 + 1.5) / 3)
+    g = int((((p >> 8) & 7) * 255 + 3.5) / 7)
+    b = int((((p >> 3) & 3) * 255 + 1.5) / 3)
+    return rgb565(r, g, b)
+
+
+# Each step changes the frame in place: noise, a changed rectangle, no change,
+# a single changed pixel, and a flat fill.
+def noise(frame, mask):
+    for y in range(H):
+        for x in range(W):
+            frame[x, y] = rand() & mask
+
+
+def rectangle(frame, mask):
+    for y in range(10, 30):
+        for x in range(5, 50):
+            frame[x, y] = (frame[x, y] + 0x1234) & mask
+
+
+def unchanged(frame, mask):
+    pass
+
+
+def one_pixel(frame, mask):
+    frame[W - 1, H - 1] ^= mask
+
+
+def flat(frame, mask):
+    frame.fill(0x5A5A & mask)
+
+
+STEPS = (noise, rectangle, unchanged, one_pixel, flat, noise)
+
+for colorspace, depth, mask, color in (
+    (Colorspace.L8, 256, 0xFF, l8_color),
+    (Colorspace.RGB565, 65536, 0xFFFF, rgb565_color),
+):
+    frame = Bitmap(W, H, depth)
+    expected = []
+    with GifWriter("/ramdisk/rt.gif", W, H, colorspace, loop=False) as g:
+        for step in STEPS:
+            step(frame, mask)
+            g.add_frame(frame, 0.01)
+            expected.append([color(frame[x, y]) for y in range(H) for x in range(W)])
+    try:
+        g.add_frame(frame, 0)
+    except ValueError:
+        print("closed")
+
+    odg = OnDiskGif("/ramdisk/rt.gif")
+    print(odg.frame_count)
+    for i, want in enumerate(expected):
+        odg.next_frame()
+        got = odg.bitmap
+        print(i, sum(1 for j in range(W * H) if got[j % W, j // W] != want[j]))
+    odg.deinit()
+
+# After the 781 byte header and color table, a flat 64x64 frame takes about
+# 100 bytes; stored uncompressed it would take over 4 KiB.
+frame = Bitmap(W, H, 256)
+with GifWriter("/ramdisk/flat.gif", W, H, Colorspace.L8, loop=False) as g:
+    g.add_frame(frame, 0)
+print(os.stat("/ramdisk/flat.gif")[6] < 1024)
+
+os.umount("/ramdisk")
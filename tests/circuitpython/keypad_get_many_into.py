@@ -0,0 +1,48 @@
+try:
+    from array import array
+    from keypad_events import Event, EventQueue, record
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+q = EventQueue(4)
+print([record(q, n, n % 2 == 0, 1000 + n) for n in range(6)])
+print(q.overflowed, len(q))
+
+# Room for two events of three elements each, with two elements left over
+buf = array("L", [99] * 8)
+print(q.get_many_into(buf), list(buf))
+print(q.overflowed, len(q))
+
+# The other two events, and then none; the buffer is left as it was
+print(q.get_many_into(buf), list(buf))
+print(q.get_many_into(buf), list(buf))
+print(q.overflowed, len(q))
+
+# A buffer too small for one event takes none
+record(q, 7, True, 2000)
+print(q.get_many_into(array("L", [99] * 2)), len(q))
+event = Event()
+print(q.get_into(event), event)
+
+# Every 32 and 64 bit element type holds the largest key number and timestamp
+for typecode in "iIlLqQ":
+    record(q, 32767, False, (1 << 29) - 1)
+    record(q, 0, True, 0)
+    buf = array(typecode, [99] * 6)
+    print(typecode, q.get_many_into(buf), list(buf))
+
+# Other element types can't hold a timestamp; nothing is taken from the queue
+record(q, 1, True, 3000)
+for buf in (bytearray(12), array("b", [0] * 12), array("h", [0] * 12), array("f", [0] * 12)):
+    try:
+        q.get_many_into(buf)
+    except ValueError as e:
+        print("ValueError", e)
+try:
+    q.get_many_into(bytes(12))
+except TypeError:
+    print("TypeError")
+print(len(q))
+q.clear()
+print(q.overflowed, len(q))
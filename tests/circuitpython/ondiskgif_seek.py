@@ -0,0 +1,99 @@
+import os
+
+try:
+    from displayio import Bitmap, Colorspace
+    from gifio import GifWriter, OnDiskGif
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMBlockDevice(64)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+
+# Frame i sets pixel (i, 0) to white, so each frame's image is distinct
+W, H, FRAMES = 8, 4, 7
+frame = Bitmap(W, H, 256)
+with GifWriter("/ramdisk/seek.gif", W, H, Colorspace.L8, loop=False) as g:
+    for i in range(FRAMES):
+        frame[i, 0] = 255
+        g.add_frame(frame, 0.01)
+
+
+def lit(bitmap):
+    return sum(1 for x in range(W) if bitmap[x, 0])
+
+
+for interval in (0, 2):
+    odg = OnDiskGif("/ramdisk/seek.gif", keyframe_interval=interval)
+    print(odg.frame_count)
+    for i in range(FRAMES):
+        odg.next_frame()
+    print(lit(odg.bitmap))
+
+    # backwards, forwards, and to each keyframe
+    for target in (3, 0, 5, 6, 2, 4, 1):
+        odg.seek(target)
+        before = lit(odg.bitmap)
+        odg.next_frame()
+        print(target, before, lit(odg.bitmap))
+
+    for bad in (-1, FRAMES):
+        try:
+            odg.seek(bad)
+        except ValueError:
+            print("ValueError", bad)
+
+    odg.deinit()
+    odg.deinit()
+    try:
+        odg.seek(0)
+    except ValueError:
+        print("deinited")
+
+
+# 2x1 frames that draw index 1 with a local color table giving it a new color each frame
+COLORS = (0xFF0000, 0x00FF00, 0x0000FF, 0xFFFFFF)
+with open("/ramdisk/palette.gif", "wb") as f:
+    f.write(b"GIF89a\x02\x00\x01\x00\x00\x00\x00")
+    for c in COLORS:
+        f.write(b"\x2c\x00\x00\x00\x00\x02\x00\x01\x00\x80\x00\x00\x00")
+        f.write(bytes((c >> 16, (c >> 8) & 0xFF, c & 0xFF)))
+        # LZW, minimum code size 2: clear, 1, 1, end of information
+        f.write(b"\x02\x02\x4c\x0a\x00")
+    f.write(b"\x3b")
+
+odg = OnDiskGif("/ramdisk/palette.gif", use_palette=True, keyframe_interval=1)
+for i in range(len(COLORS)):
+    odg.next_frame()
+print(hex(odg.palette[1]))
+for target in (2, 1, 3):
+    odg.seek(target)
+    before = odg.palette[1]
+    odg.next_frame()
+    print(target, hex(before), hex(odg.palette[1]), odg.bitmap[0, 0], odg.bitmap[1, 0])
+odg.deinit()
+
+os.umount("/ramdisk")
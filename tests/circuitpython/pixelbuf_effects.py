@@ -0,0 +1,90 @@
+import adafruit_pixelbuf
+from rainbowio import colorwheel
+
+
+class Strip(adafruit_pixelbuf.PixelBuf):
+    def _transmit(self, buf):
+        print(bytes(buf))
+
+
+def pixels(p):
+    return [p[i] for i in range(len(p))]
+
+
+def rgb(c):
+    return (c >> 16 & 0xFF, c >> 8 & 0xFF, c & 0xFF)
+
+
+# Rainbow matches colorwheel() at evenly spaced positions.
+p = Strip(4, byteorder="GRB")
+p.rainbow()
+print(pixels(p) == [rgb(colorwheel(i * 64)) for i in range(4)])
+p.rainbow(300, spread=32)
+print(pixels(p) == [rgb(colorwheel((300 + i * 8) % 256)) for i in range(4)])
+p.rainbow(-10)
+print(pixels(p) == [rgb(colorwheel((246 + i * 64) % 256)) for i in range(4)])
+
+# Gradient ends on both colors.
+p = Strip(5, byteorder="RGB")
+p.gradient((0, 0, 0), (255, 100, 0))
+print(pixels(p))
+p = Strip(1, byteorder="RGB")
+p.gradient(0x102030, 0xFFFFFF)
+print(pixels(p))
+
+# Chase runs of two, spaced by three, moving with position.
+p = Strip(8, byteorder="RGB")
+for position in (0, 1, 6, -1):
+    p.chase(position, 0xFF0000)
+    print("".join("x" if c[0] else "." for c in pixels(p)))
+p.chase(0, (1, 2, 3), background=(4, 5, 6), size=1, spacing=0)
+print(p[0], p[7])
+
+# Blend between two frames.
+a = bytes([0, 0, 0, 200, 100, 50])
+b = bytes([255, 255, 255, 0, 0, 0])
+p = Strip(2, byteorder="RGB")
+for fraction in (0, 0.5, 1):
+    p.blend(a, b, fraction)
+    print(pixels(p))
+p = Strip(2, byteorder="GRB")
+p.blend(a, b, 0, byteorder="RGB")
+print(pixels(p))
+
+# Palette cycling.
+p = Strip(5, byteorder="RGB")
+palette = (0x010000, 0x000200, (0, 0, 3))
+p.cycle_palette(palette)
+print(pixels(p))
+p.cycle_palette(palette, 1)
+print(pixels(p))
+p.cycle_palette(palette, -1, indices=b"\x00\x00\x01\x01\x02")
+print(pixels(p))
+
+# Brightness applies and auto_write shows once per effect.
+p = Strip(2, byteorder="RGB", brightness=0.5, auto_write=True)
+p.gradient(0xFF0000, 0x0000FF)
+print(pixels(p))
+
+# RGBW and DotStar default white.
+p = Strip(2, byteorder="RGBW")
+p.rainbow()
+print(pixels(p))
+p = Strip(2, byteorder="PBGR")
+p.chase(0, 0x0000FF, size=1, spacing=1)
+p.show()
+
+# Errors
+p = Strip(2, byteorder="RGB")
+for f in (
+    lambda: p.chase(0, 0, size=0),
+    lambda: p.chase(0, 0, spacing=-1),
+    lambda: p.blend(b"\x00" * 6, b"\x00" * 5, 0),
+    lambda: p.blend(b"\x00" * 6, b"\x00" * 6, 2),
+    lambda: p.cycle_palette(()),
+    lambda: p.cycle_palette((0,), indices=b"\x00"),
+):
+    try:
+        f()
+    except ValueError as e:
+        print("ValueError", e)
@@ -0,0 +1,73 @@
+import adafruit_pixelbuf
+
+
+class Strip(adafruit_pixelbuf.PixelBuf):
+    def _transmit(self, buf):
+        print(bytes(buf))
+
+
+def same(a, b):
+    return [a[i] for i in range(len(a))] == [b[i] for i in range(len(b))]
+
+
+# Reordering from RGB into GRB.
+p = Strip(3, byteorder="GRB")
+p.set_from_buffer(b"\x01\x02\x03\x04\x05\x06", byteorder="RGB", start=1)
+p.show()
+print(p[1], p[2])
+
+# Defaults to the strip's own byteorder.
+p.set_from_buffer(b"\x0a\x0b\x0c")
+p.show()
+
+# Flattened bytes in slice assignment take the same path as tuples.
+q = Strip(3, byteorder="GRB")
+q[0:2] = bytearray(range(1, 7))
+r = Strip(3, byteorder="GRB")
+r[0:2] = (1, 2, 3, 4, 5, 6)
+print(same(q, r))
+
+# Brightness and gamma are applied through the lookup table.
+p = Strip(4, byteorder="RGB", brightness=0.5)
+p.gamma = 2.0
+p.set_from_buffer(b"\x00\x80\xff" * 4)
+p.show()
+print(p[0], p.gamma)
+q = Strip(4, byteorder="RGB", brightness=0.5)
+q.gamma = 2.0
+for i in range(4):
+    q[i] = (0, 128, 255)
+q.show()
+p.gamma = 1
+p.show()
+p.brightness = 1
+p.show()
+
+# RGB source into an RGBW strip leaves white at 0.
+p = Strip(2, byteorder="GRBW")
+p.set_from_buffer(b"\x01\x02\x03", byteorder="RGB")
+p.set_from_buffer(b"\x04\x05\x06\x07", byteorder="RGBW", start=1)
+p.show()
+
+# DotStar brightness comes from P, or is full without it.
+p = Strip(2, byteorder="PBGR", header=b"\x00\x00\x00\x00", trailer=b"\xff\xff\xff\xff")
+p.set_from_buffer(b"\x01\x02\x03", byteorder="RGB")
+p.set_from_buffer(b"\x80\x04\x05\x06", byteorder="PRGB", start=1)
+p.show()
+print(p[1])
+
+# Errors
+for args, kwargs in (
+    ((b"\x01\x02",), {}),
+    ((b"\x01\x02\x03" * 3,), {"start": 0}),
+    ((b"\x01\x02\x03",), {"start": 3}),
+    ((b"\x01\x02\x03",), {"byteorder": "RGQ"}),
+):
+    try:
+        Strip(2, byteorder="RGB").set_from_buffer(*args, **kwargs)
+    except ValueError as e:
+        print("ValueError", e)
+try:
+    Strip(2).gamma = -1
+except ValueError as e:
+    print("ValueError", e)
@@ -0,0 +1,57 @@
+try:
+    from displayio import Palette
+    from vectorio import Circle, Polygon, Rectangle
+    from vectorio_fill import fill_area
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+palette = Palette(2)
+palette[0] = 0xFFFFFF
+palette[1] = 0x0000FF
+
+IDENTITY = (0, 0, 1, 1, False)
+
+
+# Draws with whole-row spans, prints the result and checks that the per-pixel
+# path draws exactly the same pixels.
+def check(name, shape, area, transform=IDENTITY, premask=0):
+    rows, pixels, full = fill_area(shape, area, transform, premask=premask)
+    ref_rows, ref_pixels, ref_full = fill_area(shape, area, transform, spans=False, premask=premask)
+    print(name, full, rows == ref_rows and pixels == ref_pixels and full == ref_full)
+    for row in rows:
+        print(row)
+
+
+check("rectangle", Rectangle(pixel_shader=palette, width=6, height=4, x=2, y=1), (0, 0, 10, 6))
+check("rectangle full", Rectangle(pixel_shader=palette, width=6, height=4, x=2, y=1), (3, 2, 7, 4))
+check("circle", Circle(pixel_shader=palette, radius=5, x=6, y=6), (0, 0, 13, 13))
+check("circle r1", Circle(pixel_shader=palette, radius=1, x=2, y=2), (0, 0, 5, 5))
+
+# Concave: a U with two prongs, so its lower rows have two spans each
+u = [(0, 0), (12, 0), (12, 10), (8, 10), (8, 4), (4, 4), (4, 10), (0, 10)]
+check("concave", Polygon(pixel_shader=palette, points=u, x=1, y=1), (0, 0, 15, 12))
+
+star = [(7, 0), (9, 5), (14, 5), (10, 8), (12, 13), (7, 10), (2, 13), (4, 8), (0, 5), (5, 5)]
+check("star", Polygon(pixel_shader=palette, points=star, x=0, y=0, color_index=1), (0, 0, 15, 14))
+
+# Self-intersecting bow tie
+bowtie = [(0, 0), (10, 8), (10, 0), (0, 8)]
+check("bowtie", Polygon(pixel_shader=palette, points=bowtie, x=1, y=0), (0, 0, 12, 9))
+
+# Clipped on every side by the area, and by the screen edge at negative x
+check("clipped", Circle(pixel_shader=palette, radius=6, x=6, y=6), (2, 3, 11, 9))
+check("offscreen", Polygon(pixel_shader=palette, points=u, x=-5, y=-2), (0, 0, 10, 10))
+
+# Mirrored and transposed group transforms, and pixels already covered
+check("mirror x", Polygon(pixel_shader=palette, points=star, x=0, y=0), (0, 0, 15, 14), (14, 0, -1, 1, False))
+check("mirror y", Polygon(pixel_shader=palette, points=u, x=1, y=1), (0, 0, 15, 12), (0, 11, 1, -1, False))
+check("transposed", Polygon(pixel_shader=palette, points=u, x=1, y=1), (0, 0, 12, 15), (0, 0, 1, 1, True))
+check("premasked", Polygon(pixel_shader=palette, points=star, x=0, y=0), (0, 0, 15, 14), premask=5)
+
+# A comb with more teeth than fill_area takes spans for falls back per pixel
+comb = [(0, 4), (0, 0)]
+for i in range(18):
+    comb += [(2 * i + 1, 0), (2 * i + 1, 3), (2 * i + 2, 3), (2 * i + 2, 0)]
+comb += [(37, 0), (37, 4)]
+check("comb", Polygon(pixel_shader=palette, points=comb, x=0, y=0), (0, 0, 38, 5))
@@ -0,0 +1,34 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# test that json.dump batches its output into a few large writes
+try:
+    import io, json
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(io, "IOBase"):
+    print("SKIP")
+    raise SystemExit
+
+
+class S(io.IOBase):
+    def __init__(self):
+        self.buf = ""
+        self.writes = 0
+
+    def write(self, buf):
+        self.buf += str(buf, "ascii")
+        self.writes += 1
+        return len(buf)
+
+
+obj = {"readings": [{"t": i, "v": i * 0.5, "ok": i % 3 == 0} for i in range(40)], "id": "x" * 300}
+for separators in (None, (",", ":")):
+    s = S()
+    json.dump(obj, s, separators=separators)
+    expected = json.dumps(obj, separators=separators)
+    print(s.buf == expected, len(expected), s.writes < 20)
+
+s = S()
+json.dump(None, s)
+print(s.buf, s.writes)
@@ -0,0 +1,64 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+try:
+    from io import StringIO, BytesIO
+    import json
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+doc = '{"name": "x", "daily": [{"t": 1.5, "w": [1, "a\\"]"]}, {"t": 2, "w": {"k": null}}], "n": -3}'
+
+
+class Buffer:
+    def __init__(self, data):
+        self._data = data
+        self._i = 0
+
+    def readinto(self, buf):
+        l = min(len(buf), len(self._data) - self._i)
+        buf[:l] = self._data[self._i : self._i + l]
+        self._i += l
+        return l
+
+
+# selecting part of a document
+print(json.loads(doc, path=("daily", 1, "w")))
+print(json.loads(doc, path=["daily", 0, "w", 1]))
+print(json.loads(doc, path=("n",)))
+print(json.loads(doc.encode(), path=()))
+print(json.load(StringIO(doc), path=("daily", 1, "t")))
+print(json.load(Buffer(doc.encode()), path=("name",)))
+for path in (("missing",), ("daily", 2), ("daily", -1), ("name", 0), ("n", "x")):
+    try:
+        json.loads(doc, path=path)
+    except (KeyError, IndexError) as e:
+        print(type(e).__name__, e)
+
+# iterating over an array or object
+print(list(json.iterload("[1, [2, 3], {}, \"4\"]")))
+print(list(json.iterload(doc, path=("daily",))))
+print(list(json.iterload(StringIO(doc))))
+print(list(json.iterload(Buffer(doc.encode()), path=("daily", 0))))
+print(list(json.iterload(BytesIO(b"  []  "))))
+print(list(json.iterload(bytearray(b'{"a": {"b": [1]}}'))))
+try:
+    json.iterload("3")
+except TypeError:
+    print("TypeError")
+try:
+    list(json.iterload("[1, 2"))
+except ValueError:
+    print("ValueError")
+
+# load only consumes the first value of a stream
+s = StringIO('{"a": 1} [2]')
+print(json.load(s), repr(s.read()))
+s = StringIO("[1,2] 3")
+print(json.load(s), json.load(s))
+
+# values longer than the read chunk size
+big = [{"i": i, "s": "x" * i} for i in range(60)]
+text = json.dumps(big)
+print(json.load(StringIO(text)) == big, json.loads(text) == big)
+print(list(json.iterload(StringIO(text))) == big)
+print(json.load(BytesIO(text.encode()), path=(59, "s")) == "x" * 59)
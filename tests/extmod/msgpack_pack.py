@@ -7,21 +7,52 @@ except ImportError:
     raise SystemExit
 
 b = BytesIO()
-msgpack.pack(False, s)
+msgpack.pack(False, b)
 print(b.getvalue())
 
 b = BytesIO()
 msgpack.pack({"a": (-1, 0, 2, [3, None], 128)}, b)
 print(b.getvalue())
 
+# Packed output larger than pack's write buffer, with a payload that bypasses it
+b = BytesIO()
+msgpack.pack([list(range(200)), bytes(range(256)) * 2, "x" * 300], b)
+print(len(b.getvalue()), msgpack.unpack(BytesIO(b.getvalue())) == [list(range(200)), bytes(range(256)) * 2, "x" * 300])
+
+
+# default converts objects that can't be packed
+class Point:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+
+def default(obj):
+    if isinstance(obj, Point):
+        return msgpack.ExtType(1, bytes([obj.x, obj.y]))
+    raise TypeError("can't pack")
+
+
+b = BytesIO()
+msgpack.pack([Point(1, 2), "b"], b, default=default)
+print(b.getvalue())
+
+# If default raises, what was packed before it is still written
+b = BytesIO()
+try:
+    msgpack.pack(["before", object()], b, default=default)
+except TypeError as e:
+    print("TypeError", e)
+print(b.getvalue())
+
 # pack to a small-int not allowed
 try:
     msgpack.pack(123, 1)
-except (AttributeError, OSError):  # CPython and uPy have different errors
-    print("Exception")
+except (AttributeError, OSError, TypeError):  # CPython and uPy have different errors
+    print("Exception to int")
 
 # pack to an object not allowed
 try:
     msgpack.pack(123, {})
-except (AttributeError, OSError):  # CPython and uPy have different errors
-    print("Exception")
+except (AttributeError, OSError, TypeError):  # CPython and uPy have different errors
+    print("Exception to object")
@@ -0,0 +1,51 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+try:
+    from io import BytesIO
+    import array
+    import msgpack
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+obj = {"a": (-1, 0, 2, [3, None], 128), "s": "x" * 40, "b": b"\x01\x02", "n": -70000}
+b = BytesIO()
+msgpack.pack(obj, b)
+data = b.getvalue()
+print(data)
+
+# unpackb() decodes the same as unpack() from a stream
+b.seek(0)
+print(msgpack.unpack(b) == msgpack.unpackb(data))
+print(sorted(msgpack.unpackb(bytearray(data), use_list=False).items()))
+print(msgpack.unpackb(memoryview(data)) == msgpack.unpackb(data))
+
+# bin and str values become memoryview slices of the input; keys stay str
+b = BytesIO()
+msgpack.pack({"bin": b"abc", "str": "hello", "list": [b"xy", "z"]}, b)
+data = b"\x00" + b.getvalue()
+d = msgpack.unpackb(memoryview(data)[1:], use_memoryview=True)
+for k in sorted(d):
+    print(k, d[k])
+print(bytes(d["bin"]), bytes(d["str"]), [bytes(x) for x in d["list"]])
+try:
+    d["bin"][0] = 0
+except TypeError:
+    print("read-only")
+
+# ext data is always bytes
+print(msgpack.unpackb(b"\xd4\x05A", use_memoryview=True).data)
+print(msgpack.unpackb(b"\xd4\x05A", ext_hook=lambda c, d: (c, d)))
+
+# array.array and bytearray pack as bin
+b = BytesIO()
+msgpack.pack([array.array("h", [1, 2]), bytearray(300)], b)
+v = msgpack.unpackb(b.getvalue())
+print(v[0], len(v[1]))
+
+for bad in (b"", b"\xa5abc", b"\x01\x02"):
+    try:
+        msgpack.unpackb(bad)
+    except EOFError:
+        print("EOFError")
+    except ValueError as e:
+        print("ValueError", e)
@@ -0,0 +1,43 @@
+# Test the linear-time matcher on patterns that are pathological for a
+# backtracking engine, and the module-level compiled-pattern cache.
+
+try:
+    import re
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# Exponential for a backtracker
+print(re.match("(a*)*b", "a" * 40))
+print(re.match("(x+x+)+y", "x" * 40))
+print(re.search("(a|aa)*c", "a" * 60))
+
+# Deep repetition that used to exhaust the C stack
+m = re.match("(ab|cd)*", "ab" * 5000 + "cd")
+print(m.group(0) == "ab" * 5000 + "cd", m.group(1))
+m = re.search("b+$", "a" * 1000 + "b" * 5000)
+print(len(m.group(0)))
+
+# Empty loops terminate
+print(re.match("(a*)*", "aaa").group(0))
+print(re.match("(a|)*b", "aab").group(0))
+print(re.match("(a?)*?c", "aac").group(0))
+
+# Leftmost-first priority and captures
+m = re.match("(a+?)(a*)", "aaaa")
+print(m.group(1), m.group(2))
+m = re.search("(a|ab)(c|bcd)(d*)", "abcd")
+print(m.groups())
+m = re.match("(a)|(b)", "b")
+print(m.groups())
+print(re.sub("(\\w+)@(\\w+)", "\\2 at \\1", "joe@example bob@test"))
+print(re.compile("[,;] *").split("a, b;c,  d"))
+
+# The module-level cache must not mix up patterns
+for i in range(3):
+    for p in ("a+", "b+", "c+", "d+", "e+", "f+", b"a+"):
+        s = "xaabbccddeeffx"
+        if isinstance(p, bytes):
+            s = b"xaabbccddeeffx"
+        print(p, re.search(p, s).group(0), end="; ")
+    print()
@@ -4,7 +4,5 @@ except ImportError:
     print("SKIP")
     raise SystemExit
 
-try:
-    re.match("(a*)*", "aaa")
-except RuntimeError:
-    print("RuntimeError")
+# This used to recurse without bound; the matcher no longer uses the C stack.
+print(re.match("(a*)*", "aaa").group(0))
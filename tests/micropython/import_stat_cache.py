@@ -0,0 +1,111 @@
+# Test that import sees filesystem changes made while directory listings are cached.
+
+import sys
+
+try:
+    import os
+
+    os.mkdir
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+def write(path, text):
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def try_import(name):
+    sys.modules.pop(name, None)
+    try:
+        print(name, __import__(name).x)
+    except ImportError:
+        print(name, "ImportError")
+
+
+def test(base):
+    sys.path.insert(0, base)
+
+    # Misses are answered from the listing, which must be dropped by writes.
+    try_import("cache_mod")
+    write(base + "/cache_mod.py", "x = 1\n")
+    try_import("cache_mod")
+
+    os.rename(base + "/cache_mod.py", base + "/cache_mod2.py")
+    try_import("cache_mod")
+    try_import("cache_mod2")
+
+    # Names match as the filesystem does: FAT ignores case, POSIX doesn't.
+    try_import("Cache_mod2")
+
+    # Packages.
+    os.mkdir(base + "/cache_pkg")
+    write(base + "/cache_pkg/__init__.py", "x = 2\n")
+    try_import("cache_pkg")
+    os.remove(base + "/cache_pkg/__init__.py")
+    os.rmdir(base + "/cache_pkg")
+    try_import("cache_pkg")
+
+    os.remove(base + "/cache_mod2.py")
+    try_import("cache_mod2")
+
+    sys.path.pop(0)
+
+
+# A host directory, which can also change outside the interpreter.
+DIR = "micropy_test_import_cache"
+os.mkdir(DIR)
+test(DIR)
+os.rmdir(DIR)
+
+# A FAT filesystem, where the listings are cached.
+bdev = RAMBlockDevice(64)
+os.VfsFat.mkfs(bdev)
+fs = os.VfsFat(bdev)
+os.mount(fs, "/ramdisk")
+test("/ramdisk")
+
+# Calling the filesystem's own methods must drop the listings too.
+sys.path.insert(0, "/ramdisk")
+try_import("cache_mod")
+with fs.open("/cache_mod.py", "w") as f:
+    f.write("x = 3\n")
+try_import("cache_mod")
+fs.rename("/cache_mod.py", "/cache_mod2.py")
+try_import("cache_mod")
+try_import("cache_mod2")
+fs.mkdir("/cache_pkg")
+with fs.open("/cache_pkg/__init__.py", "w") as f:
+    f.write("x = 4\n")
+try_import("cache_pkg")
+fs.remove("/cache_pkg/__init__.py")
+fs.rmdir("/cache_pkg")
+try_import("cache_pkg")
+fs.remove("/cache_mod2.py")
+try_import("cache_mod2")
+sys.path.pop(0)
+
+os.umount("/ramdisk")
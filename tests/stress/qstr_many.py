@@ -0,0 +1,26 @@
+# Intern many distinct names at runtime and check they can all be found again.
+
+import gc
+
+
+class A:
+    pass
+
+
+a = A()
+n = 3000
+for i in range(n):
+    setattr(a, "attr_%d" % i, i)
+gc.collect()
+print(sum(getattr(a, "attr_%d" % i) for i in range(n)) == n * (n - 1) // 2)
+print(hasattr(a, "attr_%d" % n), hasattr(a, "attr_"))
+
+# Names that are prefixes of each other and of existing qstrs
+d = {}
+for i in range(500):
+    d["k" * (i % 40 + 1) + str(i // 40)] = i
+ns = {}
+for k, v in d.items():
+    exec("%s = %d" % (k, v), ns)
+print(all(ns[k] == v for k, v in d.items()), len(d))
+print(getattr(a, "attr_1234"))
@@ -46,6 +46,50 @@ stream.set_error(errno.EAGAIN)
 buf = io.BufferedWriter(stream, 8)
 print(buf.write(bytearray(16)))
 
+# test select.poll with streams that signal readiness
+import select
+
+notifier = data[4]  # signals RD, WR, ERR and HUP with mp_stream_poll_notify()
+notifier_flags = select.POLLIN | select.POLLOUT | select.POLLERR | select.POLLHUP
+plain = data[5]  # signals nothing
+poller = select.poll()
+poller.register(notifier, select.POLLIN)
+poller.register(plain, select.POLLIN)
+print(list(poller.ipoll(20)))  # nothing ready
+print(notifier.polls(), plain.polls() > 1)  # only the plain stream is polled repeatedly
+notifier.set_ready(select.POLLIN, True, 1)  # ready after the first poll, signalled
+print([(o is notifier, e) for o, e in poller.ipoll(1000)])
+print(notifier.polls())
+notifier.set_ready(0, True, 0)
+notifier.set_ready(select.POLLIN, False, 1)  # ready after the first poll, not signalled
+print(list(poller.ipoll(20)))  # isn't seen while waiting
+print([(o is notifier, e) for o, e in poller.ipoll(0)])  # but is on the next call
+plain.set_ready(select.POLLIN, False, 0)
+print(sorted(e for o, e in poller.ipoll(0)))
+# a stream that doesn't signal HUP is still polled for it while waiting
+poller.unregister(notifier)
+poller.unregister(plain)
+notifier.set_ready(0, True, 0)
+notifier.set_notifies(select.POLLIN | select.POLLOUT)
+poller.register(notifier, 0)
+notifier.set_ready(select.POLLHUP, False, 2)  # hung up after the second poll, not signalled
+print([(o is notifier, e) for o, e in poller.ipoll(1000)])
+# only the streams that were signalled are polled again while waiting
+notifiers = [type(notifier)(notifier_flags) for _ in range(10)]
+poller = select.poll()
+for n in notifiers:
+    poller.register(n, select.POLLIN)
+notifiers[3].set_ready(select.POLLIN, 1, 1)  # ready after the first poll, signalled
+print([(o is notifiers[3], e) for o, e in poller.ipoll(1000)])
+print([n.polls() for n in notifiers])
+notifiers[3].set_ready(0, 0, 0)
+notifiers[5].set_ready(0, 8, 1)  # signalled 8 times after the first poll, never ready
+print(list(poller.ipoll(20)))
+print([n.polls() for n in notifiers])
+notifiers[5].set_ready(0, 9, 1)  # signalled more often than remembered
+print(list(poller.ipoll(20)))
+print([n.polls() for n in notifiers])
+
 # function defined in C++ code
 print("cpp", extra_cpp_coverage())
 
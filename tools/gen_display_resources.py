@@ -64,7 +64,8 @@ f.load_glyphs(set(ord(c) for c in all_characters))
 missing = 0
 # Get each glyph.
 for c in set(all_characters):
-    if ord(c) not in f._glyphs:
+    # Codepoints are stored as 16 bits so characters outside the BMP aren't supported.
+    if ord(c) not in f._glyphs or ord(c) > 0xFFFF:
         missing += 1
         filtered_characters = filtered_characters.replace(c, "")
         continue
@@ -76,15 +77,19 @@ if missing > 0:
     print("Font missing", missing, "characters", file=sys.stderr)
 
 tile_x, tile_y, dx, dy = f.get_bounding_box()
-total_bits = tile_x * len(all_characters)
+# Bitmap widths are 16 bits so large fonts wrap onto more than one row of glyphs.
+glyph_count = len(filtered_characters)
+glyphs_per_row = min(glyph_count, 0xFFFF // tile_x)
+glyph_rows = (glyph_count + glyphs_per_row - 1) // glyphs_per_row
+total_bits = tile_x * glyphs_per_row
 total_bits += 32 - total_bits % 32
 bytes_per_row = total_bits // 8
-b = bytearray(bytes_per_row * tile_y)
+b = bytearray(bytes_per_row * tile_y * glyph_rows)
 
 for x, c in enumerate(filtered_characters):
     g = f.get_glyph(ord(c))
-    start_bit = x * tile_x + g["bounds"][2]
-    start_y = (tile_y - 2) - (g["bounds"][1] + g["bounds"][3])
+    start_bit = (x % glyphs_per_row) * tile_x + g["bounds"][2]
+    start_y = (x // glyphs_per_row) * tile_y + (tile_y - 2) - (g["bounds"][1] + g["bounds"][3])
     for y, row in enumerate(g["bitmap"].rows):
         for i in range(g["bounds"][0]):
             byte = i // 8
@@ -94,10 +99,8 @@ for x, c in enumerate(filtered_characters):
                 b[overall_bit // 8] |= 1 << (7 - (overall_bit % 8))
 
 
-extra_characters = ""
-for c in filtered_characters:
-    if c not in visible_ascii:
-        extra_characters += c
+# Glyphs after the visible ascii ones are found by binary search so keep them sorted.
+extra_codepoints = sorted(ord(c) for c in filtered_characters if c not in visible_ascii)
 
 c_file = args.output_c_file
 
@@ -269,7 +272,7 @@ displayio_tilegrid_t supervisor_terminal_scroll_area_text_grid = {{
     .pixel_width = {1},
     .pixel_height = {2},
     .bitmap_width_in_tiles = {0},
-    .tiles_in_bitmap = {0},
+    .tiles_in_bitmap = {3},
     .width_in_tiles = 1,
     .height_in_tiles = 1,
     .tile_width = {1},
@@ -281,9 +284,16 @@ displayio_tilegrid_t supervisor_terminal_scroll_area_text_grid = {{
     .hidden_by_parent = false,
     .moved = false,
     .inline_tiles = false,
+    .wide_tiles = {4},
     .in_group = true
 }};
-""".format(len(all_characters), tile_x, tile_y)
+""".format(
+        glyphs_per_row,
+        tile_x,
+        tile_y,
+        glyphs_per_row * glyph_rows,
+        "true" if glyphs_per_row * glyph_rows > 256 else "false",
+    )
 )
 
 c_file.write(
@@ -297,7 +307,7 @@ displayio_tilegrid_t supervisor_terminal_status_bar_text_grid = {{
     .pixel_width = {1},
     .pixel_height = {2},
     .bitmap_width_in_tiles = {0},
-    .tiles_in_bitmap = {0},
+    .tiles_in_bitmap = {3},
     .width_in_tiles = 1,
     .height_in_tiles = 1,
     .tile_width = {1},
@@ -309,15 +319,22 @@ displayio_tilegrid_t supervisor_terminal_status_bar_text_grid = {{
     .hidden_by_parent = false,
     .moved = false,
     .inline_tiles = false,
+    .wide_tiles = {4},
     .in_group = true
 }};
-""".format(len(all_characters), tile_x, tile_y)
+""".format(
+        glyphs_per_row,
+        tile_x,
+        tile_y,
+        glyphs_per_row * glyph_rows,
+        "true" if glyphs_per_row * glyph_rows > 256 else "false",
+    )
 )
 
 c_file.write(
     """\
 const uint32_t font_bitmap_data[{}] = {{
-""".format(bytes_per_row * tile_y // 4)
+""".format(bytes_per_row * tile_y * glyph_rows // 4)
 )
 
 for i, word in enumerate(struct.iter_unpack("<I", b)):
@@ -345,10 +362,25 @@ displayio_bitmap_t supervisor_terminal_font_bitmap = {{
     .bitmask = 0x01,
     .read_only = true
 }};
-""".format(len(all_characters) * tile_x, tile_y, bytes_per_row / 4)
+""".format(glyphs_per_row * tile_x, glyph_rows * tile_y, bytes_per_row / 4)
 )
 
 
+if extra_codepoints:
+    c_file.write(
+        "const uint16_t supervisor_terminal_font_codepoints[{}] = {{\n".format(
+            len(extra_codepoints)
+        )
+    )
+    for i, codepoint in enumerate(extra_codepoints):
+        c_file.write("0x{:04x}, ".format(codepoint))
+        if (i + 1) % 8 == 0:
+            c_file.write("\n")
+    c_file.write("\n};\n")
+    codepoints = "supervisor_terminal_font_codepoints"
+else:
+    codepoints = "NULL"
+
 c_file.write(
     """\
 const fontio_builtinfont_t supervisor_terminal_font = {{
@@ -356,10 +388,10 @@ const fontio_builtinfont_t supervisor_terminal_font = {{
     .bitmap = &supervisor_terminal_font_bitmap,
     .width = {},
     .height = {},
-    .unicode_characters = (const uint8_t*) "{}",
-    .unicode_characters_len = {}
+    .unicode_codepoints = {},
+    .unicode_codepoints_len = {}
 }};
-""".format(tile_x, tile_y, extra_characters, len(extra_characters.encode("utf-8")))
+""".format(tile_x, tile_y, codepoints, len(extra_codepoints))
 )
 
 c_file.write(